@@ -0,0 +1,455 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <utils/binomial.h>
+#include <utils/math_util.h>
+#include <utils/point_generators.h>
+#include <utils/random.h>
+#include <vector>
+
+
+using namespace utils::math;
+
+namespace {
+
+// every input is generated from a fixed seed so runs are comparable between commits
+constexpr std::uint64_t seed = 0x5eed;
+constexpr double extent = 1000.0;
+
+std::vector<Point_2> make_points(std::size_t n) {
+    std::vector<Point_2> points(n);
+    generate_uniform_points(points, extent, extent, seed);
+    return points;
+}
+
+std::vector<double> make_coords(std::size_t n, std::uint64_t stream) {
+    utils::random::Xoshiro256 rng(seed + stream);
+    std::vector<double> coords(n);
+    for (auto &c : coords)
+        c = extent * rng.next_double();
+    return coords;
+}
+
+std::vector<glm::vec2> make_vec2(std::size_t n) {
+    utils::random::Xoshiro256 rng(seed);
+    std::vector<glm::vec2> points(n);
+    for (auto &p : points)
+        p = {extent * rng.next_float(), extent * rng.next_float()};
+    return points;
+}
+
+std::vector<glm::vec3> make_vec3(std::size_t n) {
+    utils::random::Xoshiro256 rng(seed);
+    std::vector<glm::vec3> points(n);
+    for (auto &p : points)
+        p = {extent * rng.next_float(), extent * rng.next_float(), extent * rng.next_float()};
+    return points;
+}
+
+// point counts 10 .. 10^7
+void point_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(10)->Range(10, 10'000'000)->Unit(benchmark::kMicrosecond);
+}
+
+// curve degrees 3 .. 20 at 1001 samples
+void curve_degrees(benchmark::internal::Benchmark *b) {
+    b->DenseRange(3, 20, 1)->Unit(benchmark::kMicrosecond);
+}
+
+constexpr double curve_step = 0.001;
+
+} // namespace
+
+/* point sets */
+
+static void BM_query_closest(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    Point_2 query(extent / 2, extent / 2);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(query_closest(points, query, 8));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_query_closest)->Apply(point_sizes);
+
+static void BM_generate_points(benchmark::State &state) {
+    auto n = static_cast<unsigned int>(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_points(n, 10'000, 10'000, seed));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_generate_points)->Apply(point_sizes);
+
+static void BM_convert_to_point_2(benchmark::State &state) {
+    auto coords = make_coords(2 * state.range(0), 0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(convert_to_point_2(coords));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_convert_to_point_2)->Apply(point_sizes);
+
+static void BM_uniform_random(benchmark::State &state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(uniform_random());
+}
+BENCHMARK(BM_uniform_random);
+
+static void BM_fill_uniform(benchmark::State &state) {
+    utils::random::Xoshiro256 rng(seed);
+    std::vector<float> values(state.range(0));
+    for (auto _ : state) {
+        utils::random::fill_uniform(values, 0.f, 1.f, rng);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_fill_uniform)->Apply(point_sizes);
+
+static void BM_fill_normal(benchmark::State &state) {
+    utils::random::Xoshiro256 rng(seed);
+    std::vector<float> values(state.range(0));
+    for (auto _ : state) {
+        utils::random::fill_normal(values, 0.f, 1.f, rng);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_fill_normal)->Apply(point_sizes);
+
+static void BM_fill_uniform_int(benchmark::State &state) {
+    utils::random::Xoshiro256 rng(seed);
+    std::vector<std::int32_t> values(state.range(0));
+    for (auto _ : state) {
+        utils::random::fill_uniform_int(values, 0, 99, rng);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_fill_uniform_int)->Apply(point_sizes);
+
+/* containment */
+
+static void BM_in_rect_scalar(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    rect r{250, 250, 500, 500};
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (const auto &p : points)
+            hits += in_rect(p, r);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_in_rect_scalar)->Apply(point_sizes);
+
+static void BM_in_rect_batch(benchmark::State &state) {
+    auto xs = make_coords(state.range(0), 0), ys = make_coords(state.range(0), 1);
+    std::vector<std::uint8_t> mask(xs.size());
+    rect r{250, 250, 500, 500};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(in_rect(xs, ys, r, mask));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_in_rect_batch)->Apply(point_sizes);
+
+static void BM_in_bounds_batch_float(benchmark::State &state) {
+    auto xd = make_coords(state.range(0), 0), yd = make_coords(state.range(0), 1);
+    std::vector<float> xs(xd.begin(), xd.end()), ys(yd.begin(), yd.end());
+    std::vector<std::uint8_t> mask(xs.size());
+    bounds b{{250, 250}, {750, 750}};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(in_bounds(std::span<const float>(xs), std::span<const float>(ys), b, mask));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_in_bounds_batch_float)->Apply(point_sizes);
+
+/* predicates */
+
+static void BM_do_intersect(benchmark::State &state) {
+    auto points = make_vec2(4 * 1024);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < points.size(); i += 4)
+            hits += do_intersect(points[i], points[i + 1], points[i + 2], points[i + 3]);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_do_intersect);
+
+static void BM_orientation(benchmark::State &state) {
+    auto points = make_vec2(state.range(0) + 2);
+    for (auto _ : state) {
+        int total = 0;
+        for (std::size_t i = 0; i + 2 < points.size(); i++)
+            total += orientation(points[i], points[i + 1], points[i + 2]);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_orientation)->Apply(point_sizes);
+
+static void BM_on_segment(benchmark::State &state) {
+    auto points = make_vec2(state.range(0) + 2);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i + 2 < points.size(); i++)
+            hits += on_segment(points[i], points[i + 1], points[i + 2]);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_on_segment)->Apply(point_sizes);
+
+static void BM_cross2d(benchmark::State &state) {
+    auto xs = make_coords(state.range(0) + 3, 0), ys = make_coords(state.range(0) + 3, 1);
+    for (auto _ : state) {
+        double total = 0;
+        for (std::size_t i = 0; i + 3 < xs.size(); i++)
+            total += cross2d({xs[i], ys[i]}, {xs[i + 1], ys[i + 1]}, {xs[i + 2], ys[i + 2]}, {xs[i + 3], ys[i + 3]});
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_cross2d)->Apply(point_sizes);
+
+// nearly colinear triplets force the exact fallback
+static void BM_orient2d_degenerate(benchmark::State &state) {
+    auto xs = make_coords(1024, 0);
+    for (auto _ : state) {
+        double total = 0;
+        for (auto x : xs)
+            total += orient2d({0.1, 0.1}, {x, x}, {2 * x + 0.1, 2 * x + 0.1});
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_orient2d_degenerate);
+
+static void BM_compute_triangle_circumcenter(benchmark::State &state) {
+    auto points = make_vec2(3 * 1024);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); i += 3)
+            benchmark::DoNotOptimize(compute_triangle_circumcenter(points[i], points[i + 1], points[i + 2]));
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_compute_triangle_circumcenter);
+
+static void BM_compute_parabolic_collision_x(benchmark::State &state) {
+    auto points = make_vec2(2 * 1024);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); i += 2)
+            benchmark::DoNotOptimize(compute_parabolic_collision_x(points[i], points[i + 1], 2 * extent));
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_compute_parabolic_collision_x);
+
+static void BM_compute_parabola_y(benchmark::State &state) {
+    auto xs = make_coords(state.range(0), 0);
+    glm::dvec2 focus(extent / 2, extent / 2);
+    for (auto _ : state) {
+        double total = 0;
+        for (auto x : xs)
+            total += compute_parabola_y(focus, 2 * extent, x);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_compute_parabola_y)->Apply(point_sizes);
+
+static void BM_generate_parabola(benchmark::State &state) {
+    auto xs = make_coords(state.range(0), 0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_parabola(xs, 0.5, 1, 2));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_generate_parabola)->Apply(point_sizes);
+
+/* binomials */
+
+static void BM_binomial_coeff(benchmark::State &state) {
+    for (auto _ : state) {
+        int total = 0;
+        for (int n = 0; n <= 33; ++n)
+            for (int k = 0; k <= n; ++k)
+                total += binomial_coeff(n, k);
+        benchmark::DoNotOptimize(total);
+    }
+}
+BENCHMARK(BM_binomial_coeff);
+
+static void BM_generate_binomial_matrix(benchmark::State &state) {
+    auto n = static_cast<int>(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_binomial_matrix(n));
+}
+BENCHMARK(BM_generate_binomial_matrix)->Apply(curve_degrees);
+
+/* curves */
+
+static void BM_generate_bezier_curve_2d(benchmark::State &state) {
+    auto controls = make_vec2(state.range(0) + 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_bezier_curve(controls, curve_step));
+}
+BENCHMARK(BM_generate_bezier_curve_2d)->Apply(curve_degrees);
+
+static void BM_generate_bezier_curve_3d(benchmark::State &state) {
+    auto controls = make_vec3(state.range(0) + 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_bezier_curve(controls, curve_step));
+}
+BENCHMARK(BM_generate_bezier_curve_3d)->Apply(curve_degrees);
+
+static void BM_flatten_bezier_curve_2d(benchmark::State &state) {
+    auto controls = make_vec2(state.range(0) + 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(flatten_bezier_curve(controls, 0.01));
+}
+BENCHMARK(BM_flatten_bezier_curve_2d)->Apply(curve_degrees);
+
+static void BM_bezier_polynomial(benchmark::State &state) {
+    auto controls = make_coords(2 * (state.range(0) + 1), 0);
+    std::vector<float> points(controls.begin(), controls.end());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(bezier_polynomial(points, curve_step, 2));
+}
+BENCHMARK(BM_bezier_polynomial)->Apply(curve_degrees);
+
+static void BM_bezier_deCasteljau(benchmark::State &state) {
+    auto controls = make_coords(2 * (state.range(0) + 1), 0);
+    std::vector<float> points(controls.begin(), controls.end());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(bezier_deCasteljau(points, curve_step, 2));
+}
+BENCHMARK(BM_bezier_deCasteljau)->Apply(curve_degrees);
+
+// one sample of the curve
+static void BM_deCasteljau_kernel(benchmark::State &state) {
+    auto controls = make_coords(2 * (state.range(0) + 1), 0);
+    std::vector<float> points(controls.begin(), controls.end());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(deCasteljau_kernel(points, 0.5, 2));
+}
+BENCHMARK(BM_deCasteljau_kernel)->Apply(curve_degrees);
+
+static void BM_bezier_matrix(benchmark::State &state) {
+    auto controls = make_coords(2 * (state.range(0) + 1), 0);
+    std::vector<float> points(controls.begin(), controls.end());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(bezier_matrix(points, curve_step, 2));
+}
+BENCHMARK(BM_bezier_matrix)->Apply(curve_degrees);
+
+// 1024 cubics sharing one basis
+static void BM_bezier_matrix_batch(benchmark::State &state) {
+    constexpr std::size_t curves = 1024;
+    auto controls = make_coords(curves * 4 * 2, 0);
+    std::vector<float> points(controls.begin(), controls.end());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(bezier_matrix(points, curves, curve_step, 2));
+    state.SetItemsProcessed(state.iterations() * curves);
+}
+BENCHMARK(BM_bezier_matrix_batch)->Unit(benchmark::kMicrosecond);
+
+/* 3-D primitives */
+
+static void BM_generate_sphere(benchmark::State &state) {
+    double step = 1.0 / static_cast<double>(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_sphere(1.0, step, step));
+}
+BENCHMARK(BM_generate_sphere)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
+
+static void BM_generate_cylinder(benchmark::State &state) {
+    double step = 1.0 / static_cast<double>(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(generate_cylinder(1.0, 1.0, step, step));
+}
+BENCHMARK(BM_generate_cylinder)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
+
+static void BM_generate_box(benchmark::State &state) {
+    auto sizes = make_coords(state.range(0), 0);
+    for (auto _ : state) {
+        for (auto size : sizes)
+            benchmark::DoNotOptimize(generate_box(size, 2 * size, 3 * size));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_generate_box)->Apply(point_sizes);
+
+/* hashing */
+
+static void BM_hash_point_2(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    std::hash<Point_2> hash;
+    for (auto _ : state) {
+        std::size_t total = 0;
+        for (const auto &p : points)
+            total ^= hash(p);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hash_point_2)->Apply(point_sizes);
+
+static void BM_hash_vec2(benchmark::State &state) {
+    auto points = make_vec2(state.range(0));
+    std::hash<glm::vec2> hash;
+    for (auto _ : state) {
+        std::size_t total = 0;
+        for (const auto &p : points)
+            total ^= hash(p);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hash_vec2)->Apply(point_sizes);
+
+static void BM_hash_mix(benchmark::State &state) {
+    for (auto _ : state) {
+        std::uint64_t total = 0;
+        for (std::int64_t i = 0; i < state.range(0); i++)
+            total ^= hash_mix(static_cast<std::uint64_t>(i));
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hash_mix)->Apply(point_sizes);
+
+static void BM_hash_bits(benchmark::State &state) {
+    auto xs = make_coords(state.range(0), 0);
+    for (auto _ : state) {
+        std::uint64_t total = 0;
+        for (auto x : xs)
+            total ^= hash_bits(x);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hash_bits)->Apply(point_sizes);
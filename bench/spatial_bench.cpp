@@ -0,0 +1,183 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utils/point_cloud.h>
+#include <utils/point_generators.h>
+#include <utils/point_index.h>
+#include <utils/random.h>
+#include <utils/segment_intersection.h>
+#include <utils/spatial_hash_grid.h>
+#include <utils/voronoi.h>
+#include <vector>
+
+
+using namespace utils::math;
+
+namespace {
+
+constexpr std::uint64_t seed = 0x5eed;
+constexpr double extent = 1000.0;
+
+std::vector<Point_2> make_points(std::size_t n) {
+    std::vector<Point_2> points(n);
+    generate_uniform_points(points, extent, extent, seed);
+    return points;
+}
+
+void point_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(10)->Range(10, 10'000'000)->Unit(benchmark::kMicrosecond);
+}
+
+// about one point per cell on average
+double grid_cell_size(std::size_t n) {
+    return extent / std::sqrt(std::max<double>(1.0, n));
+}
+
+} // namespace
+
+static void BM_PointIndex2D_build(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PointIndex2D(points));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PointIndex2D_build)->Apply(point_sizes);
+
+static void BM_PointIndex2D_query_closest(benchmark::State &state) {
+    PointIndex2D index(make_points(state.range(0)));
+    std::vector<Point_2> queries(1024);
+    generate_uniform_points(queries, extent, extent, seed + 1);
+    std::size_t indices[8];
+    double sq_distances[8];
+    for (auto _ : state) {
+        for (const auto &q : queries)
+            benchmark::DoNotOptimize(index.query_closest(q, indices, sq_distances));
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_PointIndex2D_query_closest)->Apply(point_sizes);
+
+static void BM_PointIndex2D_batch_query_closest(benchmark::State &state) {
+    constexpr std::size_t k = 8;
+    PointIndex2D index(make_points(state.range(0)));
+    std::vector<Point_2> queries(1 << 16);
+    generate_uniform_points(queries, extent, extent, seed + 1);
+    std::vector<std::size_t> indices(queries.size() * k);
+    std::vector<double> sq_distances(queries.size() * k);
+    for (auto _ : state)
+        query_closest(index, queries, k, indices, sq_distances);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_PointIndex2D_batch_query_closest)->Apply(point_sizes)->UseRealTime();
+
+static void BM_build_knn_graph(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(build_knn_graph(points, 8));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_build_knn_graph)->RangeMultiplier(10)->Range(10, 1'000'000)->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+static void BM_SpatialHashGrid2D_rebuild(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    SpatialHashGrid2D grid(grid_cell_size(points.size()));
+    for (auto _ : state)
+        grid.rebuild(std::span<const Point_2>(points));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialHashGrid2D_rebuild)->Apply(point_sizes)->UseRealTime();
+
+// every point takes a small step, as in one simulation tick
+static void BM_SpatialHashGrid2D_move(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    SpatialHashGrid2D grid(grid_cell_size(points.size()));
+    grid.rebuild(std::span<const Point_2>(points));
+    utils::random::Xoshiro256 rng(seed + 1);
+    const double step = grid.cell_size() / 4;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); i++) {
+            points[i] = Point_2(points[i].x() + step * (rng.next_double() - 0.5),
+                                points[i].y() + step * (rng.next_double() - 0.5));
+            grid.move(i, points[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialHashGrid2D_move)->Apply(point_sizes);
+
+static void BM_SpatialHashGrid2D_query_closest(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    SpatialHashGrid2D grid(grid_cell_size(points.size()));
+    grid.rebuild(std::span<const Point_2>(points));
+    std::vector<Point_2> queries(1024);
+    generate_uniform_points(queries, extent, extent, seed + 1);
+    std::size_t indices[8];
+    double sq_distances[8];
+    for (auto _ : state) {
+        for (const auto &q : queries)
+            benchmark::DoNotOptimize(grid.query_closest(q, indices, sq_distances));
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_SpatialHashGrid2D_query_closest)->Apply(point_sizes);
+
+static void BM_compute_voronoi(benchmark::State &state) {
+    auto points = make_points(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(compute_voronoi(points));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_compute_voronoi)->RangeMultiplier(10)->Range(10, 1'000'000)->Unit(benchmark::kMillisecond);
+
+// short random segments, so the intersection count grows linearly with n
+static void BM_find_segment_intersections(benchmark::State &state) {
+    utils::random::Xoshiro256 rng(seed);
+    std::vector<line_segment> segments(state.range(0));
+    for (auto &s : segments) {
+        s.start = {extent * rng.next_double(), extent * rng.next_double()};
+        s.end = s.start + glm::dvec2(rng.next_double() - 0.5, rng.next_double() - 0.5);
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(find_segment_intersections(segments));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_find_segment_intersections)->RangeMultiplier(10)->Range(10, 1'000'000)
+        ->Unit(benchmark::kMillisecond);
+
+static void BM_PointCloud3D_transform(benchmark::State &state) {
+    PointCloud3D cloud(state.range(0));
+    glm::mat4 m(1.0f);
+    m[3] = glm::vec4(1.0f, 2.0f, 3.0f, 1.0f);
+    for (auto _ : state) {
+        cloud.transform(m);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 3 * sizeof(float));
+}
+BENCHMARK(BM_PointCloud3D_transform)->Apply(point_sizes);
@@ -0,0 +1,239 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_BEZIER_H
+#define UTILS_BEZIER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+
+namespace utils::math {
+
+// out (samples x Dim) = control points applied to weights laid out as (degree + 1) rows of samples each;
+// the product every evaluator below shares, vectorized across samples
+template <std::size_t Dim, typename T>
+void apply_bezier_weights(const T *weights, std::size_t degree, std::size_t samples, const T *control_points,
+                          T *out) {
+	std::fill(out, out + samples * Dim, T(0));
+	for (std::size_t k = 0; k <= degree; k++) {
+		const T *w = weights + k * samples;
+		T p[Dim];
+		for (std::size_t d = 0; d < Dim; d++)
+			p[d] = control_points[k * Dim + d];
+		for (std::size_t s = 0; s < samples; s++) {
+			for (std::size_t d = 0; d < Dim; d++)
+				out[s * Dim + d] += w[s] * p[d];
+		}
+	}
+}
+
+// the same for a dimension only known at run time
+template <typename T>
+void apply_bezier_weights(const T *weights, std::size_t degree, std::size_t samples, std::size_t dimension,
+                          const T *control_points, T *out) {
+	switch (dimension) {
+		case 1:
+			return apply_bezier_weights<1>(weights, degree, samples, control_points, out);
+		case 2:
+			return apply_bezier_weights<2>(weights, degree, samples, control_points, out);
+		case 3:
+			return apply_bezier_weights<3>(weights, degree, samples, control_points, out);
+		case 4:
+			return apply_bezier_weights<4>(weights, degree, samples, control_points, out);
+		default:
+			break;
+	}
+	std::fill(out, out + samples * dimension, T(0));
+	for (std::size_t k = 0; k <= degree; k++) {
+		const T *w = weights + k * samples;
+		const T *p = control_points + k * dimension;
+		for (std::size_t s = 0; s < samples; s++) {
+			for (std::size_t d = 0; d < dimension; d++)
+				out[s * dimension + d] += w[s] * p[d];
+		}
+	}
+}
+
+// Bezier evaluator for a fixed degree and step size. The Bernstein weights of every sample are
+// computed once up front, after which evaluate() is allocation free and vectorizes across samples.
+// Samples are taken at t = 0, step_size, 2 * step_size, ... while t < 1, like generate_bezier_curve.
+template <std::size_t Dim, typename T = float>
+class BezierCurve {
+public:
+	BezierCurve(std::size_t degree, double step_size)
+			: degree_(degree), step_size_(step_size), samples_(sample_count(step_size)),
+			  weights_((degree + 1) * samples_) {
+		std::vector<double> basis(degree + 1);
+		double t = 0.0;
+		for (std::size_t s = 0; s < samples_; s++) {
+			// raise the degree one step at a time: B(j, k) = (1 - t) B(j - 1, k) + t B(j - 1, k - 1)
+			basis[0] = 1.0;
+			for (std::size_t j = 1; j <= degree; j++) {
+				basis[j] = t * basis[j - 1];
+				for (std::size_t k = j - 1; k > 0; k--)
+					basis[k] = (1.0 - t) * basis[k] + t * basis[k - 1];
+				basis[0] *= 1.0 - t;
+			}
+			for (std::size_t k = 0; k <= degree; k++)
+				weights_[k * samples_ + s] = static_cast<T>(basis[k]);
+			// accumulate t the same way the other curve generators do
+			t = s == 0 ? step_size : t + step_size;
+		}
+	}
+
+	// number of parameter values visited for step_size, the same count generate_bezier_curve produces
+	static std::size_t sample_count(double step_size) {
+		assert(step_size > 0);
+		std::size_t count = 1;
+		for (double t = step_size; t < 1.0; t += step_size)
+			count++;
+		return count;
+	}
+
+	[[nodiscard]]
+	std::size_t degree() const {
+		return degree_;
+	}
+
+	[[nodiscard]]
+	double step_size() const {
+		return step_size_;
+	}
+
+	[[nodiscard]]
+	std::size_t sample_count() const {
+		return samples_;
+	}
+
+	// (degree + 1) rows of sample_count() weights, for apply_bezier_weights in any dimension
+	[[nodiscard]]
+	std::span<const T> weights() const {
+		return weights_;
+	}
+
+	// control_points holds (degree + 1) * Dim values, out receives sample_count() * Dim values
+	void evaluate(std::span<const T> control_points, std::span<T> out) const {
+		assert(control_points.size() >= (degree_ + 1) * Dim);
+		assert(out.size() >= samples_ * Dim);
+		apply_bezier_weights<Dim>(weights_.data(), degree_, samples_, control_points.data(), out.data());
+	}
+
+private:
+	std::size_t degree_;
+	double step_size_;
+	std::size_t samples_;
+	// (degree + 1) rows of samples_ weights each
+	std::vector<T> weights_;
+};
+
+// Adaptive flattening: splits the curve in half until the control polygon of every piece lies within
+// tolerance of its chord, which bounds the curve's deviation by the convex hull property. Calls emit
+// with a pointer to Dim values for the first control point and the end of every piece, in order.
+template <std::size_t Dim, typename T, typename Emit>
+void flatten_bezier_curve(std::span<const T> control_points, double tolerance, Emit &&emit,
+                          std::size_t max_depth = 16) {
+	assert(control_points.size() % Dim == 0);
+	const std::size_t count = control_points.size() / Dim;
+	if (count == 0)
+		return;
+	emit(control_points.data());
+	if (count == 1)
+		return;
+
+	const std::size_t stride = count * Dim;
+	const double sq_tolerance = tolerance * tolerance;
+	// pieces still to flatten, each a control polygon plus its depth, right halves pushed first
+	std::vector<T> stack(control_points.begin(), control_points.end());
+	std::vector<std::size_t> depths{0};
+	std::vector<T> levels(stride);
+	stack.reserve((max_depth + 2) * stride);
+
+	auto flat = [&](const T *poly) {
+		const T *a = poly, *b = poly + (count - 1) * Dim;
+		double chord[Dim], sq_length = 0;
+		for (std::size_t d = 0; d < Dim; d++) {
+			chord[d] = static_cast<double>(b[d]) - a[d];
+			sq_length += chord[d] * chord[d];
+		}
+		for (std::size_t i = 1; i + 1 < count; i++) {
+			const T *p = poly + i * Dim;
+			double t = 0;
+			for (std::size_t d = 0; d < Dim; d++)
+				t += (static_cast<double>(p[d]) - a[d]) * chord[d];
+			t = sq_length > 0 ? std::clamp(t / sq_length, 0.0, 1.0) : 0.0;
+			double sq_distance = 0;
+			for (std::size_t d = 0; d < Dim; d++) {
+				double delta = static_cast<double>(p[d]) - (a[d] + t * chord[d]);
+				sq_distance += delta * delta;
+			}
+			if (sq_distance > sq_tolerance)
+				return false;
+		}
+		return true;
+	};
+
+	while (!depths.empty()) {
+		const std::size_t depth = depths.back();
+		const std::size_t top = stack.size() - stride;
+		if (depth >= max_depth || flat(stack.data() + top)) {
+			emit(stack.data() + top + (count - 1) * Dim);
+			stack.resize(top);
+			depths.pop_back();
+			continue;
+		}
+		// de Casteljau at t = 0.5: left half takes the first point of every level, right half the last
+		std::copy(stack.begin() + top, stack.end(), levels.begin());
+		stack.resize(top + 2 * stride);
+		T *right = stack.data() + top, *left = right + stride;
+		for (std::size_t level = 0; level < count; level++) {
+			const std::size_t last = count - 1 - level;
+			for (std::size_t d = 0; d < Dim; d++) {
+				left[level * Dim + d] = levels[d];
+				right[last * Dim + d] = levels[last * Dim + d];
+			}
+			for (std::size_t i = 0; i < last; i++) {
+				for (std::size_t d = 0; d < Dim; d++)
+					levels[i * Dim + d] = (levels[i * Dim + d] + levels[(i + 1) * Dim + d]) * T(0.5);
+			}
+		}
+		depths.back() = depth + 1;
+		depths.push_back(depth + 1);
+	}
+}
+
+template <std::size_t Dim, typename T>
+void flatten_bezier_curve(std::span<const T> control_points, double tolerance, std::vector<T> &out,
+                          std::size_t max_depth = 16) {
+	flatten_bezier_curve<Dim, T>(control_points, tolerance, [&](const T *p) {
+		out.insert(out.end(), p, p + Dim);
+	}, max_depth);
+}
+
+} // namespace utils::math
+
+#endif //UTILS_BEZIER_H
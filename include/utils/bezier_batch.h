@@ -0,0 +1,137 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_BEZIER_BATCH_H
+#define UTILS_BEZIER_BATCH_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utils/bezier.h>
+#include <utils/thread_pool.h>
+#include <vector>
+
+
+namespace utils::math {
+
+// Batches keep every curve's control points in one buffer: curve i owns points
+// [offsets[i], offsets[i + 1]) of control_points, counted in points of Dim values,
+// so offsets holds one entry more than there are curves. Results use the same layout.
+
+// points generate_bezier_curve returns for one curve: its control points when there are at most two,
+// otherwise the samples
+template <std::size_t Dim, typename T = float>
+std::size_t tessellated_points(std::size_t control_points, double step_size) {
+	return control_points <= 2 ? control_points : BezierCurve<Dim, T>::sample_count(step_size);
+}
+
+// scalars tessellate_bezier_curves writes for a batch of curves
+template <std::size_t Dim, typename T = float>
+std::size_t tessellated_size(std::span<const std::size_t> offsets, double step_size) {
+	std::size_t points = 0;
+	for (std::size_t i = 0; i + 1 < offsets.size(); i++)
+		points += tessellated_points<Dim, T>(offsets[i + 1] - offsets[i], step_size);
+	return points * Dim;
+}
+
+// Samples every curve like generate_bezier_curve into one buffer, curves spread over the pool;
+// curves of one or two points are copied through unchanged, as there.
+// out needs tessellated_size() values and out_offsets one entry per curve plus one.
+template <std::size_t Dim, typename T>
+void tessellate_bezier_curves(std::span<const T> control_points, std::span<const std::size_t> offsets,
+                              double step_size, std::span<T> out, std::span<std::size_t> out_offsets,
+                              parallel::ThreadPool &pool = parallel::ThreadPool::global()) {
+	const std::size_t curves = offsets.empty() ? 0 : offsets.size() - 1;
+	const std::size_t samples = BezierCurve<Dim, T>::sample_count(step_size);
+	assert(out_offsets.size() >= curves + 1);
+
+	// one evaluator per degree in the batch, shared read only by every worker
+	std::vector<std::unique_ptr<BezierCurve<Dim, T>>> evaluators;
+	out_offsets[0] = 0;
+	for (std::size_t i = 0; i < curves; i++) {
+		assert(offsets[i] < offsets[i + 1]);
+		const std::size_t points = offsets[i + 1] - offsets[i];
+		out_offsets[i + 1] = out_offsets[i] + tessellated_points<Dim, T>(points, step_size);
+		if (points <= 2)
+			continue;
+		if (points > evaluators.size())
+			evaluators.resize(points);
+		if (!evaluators[points - 1])
+			evaluators[points - 1] = std::make_unique<BezierCurve<Dim, T>>(points - 1, step_size);
+	}
+	assert(out.size() >= out_offsets[curves] * Dim);
+
+	// roughly 16k samples per chunk whatever the step size
+	const std::size_t grain = std::max<std::size_t>(1, (std::size_t{1} << 14) / samples);
+	pool.parallel_for(curves, grain, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++) {
+			const std::size_t points = offsets[i + 1] - offsets[i];
+			auto source = control_points.subspan(offsets[i] * Dim, points * Dim);
+			auto target = out.subspan(out_offsets[i] * Dim, (out_offsets[i + 1] - out_offsets[i]) * Dim);
+			if (points <= 2)
+				std::copy(source.begin(), source.end(), target.begin());
+			else
+				evaluators[points - 1]->evaluate(source, target);
+		}
+	});
+}
+
+// Adaptively flattens every curve like flatten_bezier_curve, replacing out with the vertices of all
+// curves back to back and out_offsets with their boundaries in points.
+template <std::size_t Dim, typename T>
+void flatten_bezier_curves(std::span<const T> control_points, std::span<const std::size_t> offsets,
+                           double tolerance, std::vector<T> &out, std::vector<std::size_t> &out_offsets,
+                           parallel::ThreadPool &pool = parallel::ThreadPool::global()) {
+	const std::size_t curves = offsets.empty() ? 0 : offsets.size() - 1;
+	constexpr std::size_t grain = 64;
+	const std::size_t chunks = (curves + grain - 1) / grain;
+
+	// vertex counts aren't known up front, so each chunk flattens into its own buffer first
+	std::vector<std::vector<T>> buffers(chunks);
+	out_offsets.assign(curves + 1, 0);
+	pool.parallel_for(curves, grain, [&](std::size_t begin, std::size_t end) {
+		auto &buffer = buffers[begin / grain];
+		for (std::size_t i = begin; i < end; i++) {
+			const std::size_t before = buffer.size();
+			flatten_bezier_curve<Dim, T>(
+					control_points.subspan(offsets[i] * Dim, (offsets[i + 1] - offsets[i]) * Dim),
+					tolerance, buffer);
+			out_offsets[i + 1] = (buffer.size() - before) / Dim;
+		}
+	});
+	for (std::size_t i = 0; i < curves; i++)
+		out_offsets[i + 1] += out_offsets[i];
+
+	out.resize(out_offsets[curves] * Dim);
+	pool.parallel_for(chunks, 1, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t c = begin; c < end; c++)
+			std::copy(buffers[c].begin(), buffers[c].end(), out.begin() + out_offsets[c * grain] * Dim);
+	});
+}
+
+} // namespace utils::math
+
+#endif //UTILS_BEZIER_BATCH_H
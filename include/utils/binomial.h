@@ -0,0 +1,71 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_BINOMIAL_H
+#define UTILS_BINOMIAL_H
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+
+namespace utils::math {
+
+// largest n for which every C(n, k) fits the result type
+constexpr int max_binomial_degree_int = 33;
+constexpr int max_binomial_degree_u64 = 67;
+constexpr int max_binomial_degree_f64 = 1029;
+
+namespace detail {
+
+// rows 0 to max_binomial_degree_u64 of Pascal's triangle, row n starting at n * (n + 1) / 2
+constexpr auto pascal_triangle = [] {
+	constexpr int rows = max_binomial_degree_u64 + 1;
+	std::array<std::uint64_t, rows * (rows + 1) / 2> table{};
+	for (int n = 0; n < rows; n++) {
+		auto *row = &table[n * (n + 1) / 2];
+		const auto *above = &table[(n - 1) * n / 2];
+		row[0] = row[n] = 1;
+		for (int k = 1; k < n; k++)
+			row[k] = above[k - 1] + above[k];
+	}
+	return table;
+}();
+
+} // namespace detail
+
+constexpr std::uint64_t binomial_coeff_u64(int n, int k) {
+	assert(n >= 0 && n <= max_binomial_degree_u64);
+	if (k < 0 || k > n)
+		return 0;
+	return detail::pascal_triangle[n * (n + 1) / 2 + k];
+}
+
+// read from the compile time table up to max_binomial_degree_u64; rows above that are built once on
+// first use and then read without locking, so this is safe to call from any thread
+double binomial_coeff_f64(int n, int k);
+
+} // namespace utils::math
+
+#endif //UTILS_BINOMIAL_H
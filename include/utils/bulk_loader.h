@@ -0,0 +1,94 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_BULK_LOADER_H
+#define UTILS_BULK_LOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <span>
+#include <string>
+#include <utils/file_util.h>
+#include <utils/thread_pool.h>
+#include <variant>
+#include <vector>
+
+
+namespace utils::file {
+
+enum class decode_kind {
+	// the bytes as a string, like read_file_to_string
+	raw,
+	// like read_json_file without a schema, honouring the json cache
+	json,
+	// like read_png_file, the pixels stay on the cpu
+	png
+};
+
+struct bulk_load_options {
+	decode_kind kind{decode_kind::raw};
+	// total size of the files being read or decoded and not yet delivered; a file larger than the cap
+	// is loaded on its own. Decoded sizes (png pixels, json documents) are not counted.
+	std::uint64_t memory_cap{std::uint64_t{256} << 20};
+	// files being read at once
+	std::size_t queue_depth{64};
+	// decoding (and reading, without io_uring) runs here, ThreadPool::global() when null
+	parallel::ThreadPool *pool{nullptr};
+};
+
+struct loaded_file {
+	// position in the paths passed in
+	std::size_t index;
+	std::string path;
+	// string for raw, json for json, image for png; left empty when loading failed
+	std::variant<std::string, json, image> content;
+	// runtime_error (or the parser's exception) when the file could not be read or decoded
+	std::exception_ptr error;
+};
+
+// called once per file, from worker threads and possibly concurrently; move the content out to keep it
+using loaded_file_callback = std::function<void(loaded_file &)>;
+
+// Reads and decodes many files at once, through io_uring when the library was built with UTILS_IO_URING
+// and the kernel allows it, otherwise with blocking reads on the pool. Files are delivered in the order
+// they finish and their memory counts against the cap until the callback returns. Blocks until every
+// file has been delivered and rethrows the first exception thrown by the callback. The calling thread
+// only waits, so call it from outside the pool.
+void load_files(std::span<const std::string> paths,
+                const bulk_load_options &options,
+                const loaded_file_callback &callback);
+
+// as above but returns at once, future i becoming ready with file i. Loading errors are stored in
+// loaded_file::error, not the future. A file stops counting against the cap once its future is ready,
+// so here the cap only bounds the files still being read or decoded: results waiting to be collected
+// are not limited. Use load_files when the results themselves must stay under the cap.
+std::vector<std::future<loaded_file>> load_files_async(std::vector<std::string> paths,
+                                                       const bulk_load_options &options);
+
+} // namespace utils::file
+
+#endif //UTILS_BULK_LOADER_H
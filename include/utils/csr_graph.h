@@ -0,0 +1,61 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_CSR_GRAPH_H
+#define UTILS_CSR_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace utils::graph {
+
+// compressed sparse row adjacency: the out edges of vertex v are neighbors[offsets[v], offsets[v + 1])
+// with their weights at the same positions
+struct csr_graph {
+	std::vector<std::size_t> offsets;
+	std::vector<std::uint32_t> neighbors;
+	std::vector<float> weights;
+
+	[[nodiscard]]
+	std::size_t vertex_count() const {
+		return offsets.empty() ? 0 : offsets.size() - 1;
+	}
+
+	[[nodiscard]]
+	std::span<const std::uint32_t> neighbors_of(std::uint32_t v) const {
+		return std::span(neighbors).subspan(offsets[v], offsets[v + 1] - offsets[v]);
+	}
+
+	[[nodiscard]]
+	std::span<const float> weights_of(std::uint32_t v) const {
+		return std::span(weights).subspan(offsets[v], offsets[v + 1] - offsets[v]);
+	}
+};
+
+} // namespace utils::graph
+
+#endif //UTILS_CSR_GRAPH_H
@@ -26,21 +26,52 @@ SOFTWARE.
 #define UTILS_FILE_UTIL_H
 
 #include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json-schema.hpp>
+#include <span>
 #include <string>
+#include <utils/schema_registry.h>
+#include <vector>
 
 
 using json = nlohmann::json;
 
 namespace utils::file {
 
+// validation errors against schema are printed to stderr, the schema is compiled once through SchemaRegistry::global()
 json read_json_file(const std::string &path, const json &schema = nullptr);
 
+// as above, but the validation errors are returned in result instead of printed
+json read_json_file(const std::string &path, const json &schema, validation_result &result);
+
+// with the json cache on (json_cache.h) this also refreshes the binary sidecar read_json_file prefers
 void write_json_file(const std::string &path, const json &data);
 
+// decoded pixels in memory, rows top to bottom without padding
+struct image {
+	std::uint32_t width{0};
+	std::uint32_t height{0};
+	// 1 gray, 2 gray and alpha, 3 rgb, 4 rgba
+	std::uint8_t channels{0};
+	// bits per channel, 8 or 16; 16 bit samples are in native byte order
+	std::uint8_t bit_depth{0};
+	std::vector<std::uint8_t> pixels;
+};
+
+// palette and low bit depth images are expanded to 8 bit channels, transparency chunks to alpha.
+// name only labels errors
+image decode_png(std::span<const std::byte> bytes, const std::string &name = "png buffer");
+
+image read_png_file(const std::string &path);
+
+// needs a current GL context, only rgb and rgba images are supported
+GLuint image_to_texture(const image &picture);
+
 GLuint read_png_file_to_texture(const std::string &path);
 
+// copies the whole file, see mapped_file.h for reading in place
 std::string read_file_to_string(const std::string &path);
 
 } // namespace utils::file
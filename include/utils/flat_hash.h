@@ -0,0 +1,237 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_FLAT_HASH_H
+#define UTILS_FLAT_HASH_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <utils/math_util.h>
+#include <vector>
+
+
+namespace utils::math {
+
+// for integer keys, whose std::hash is usually the identity
+struct MixHash {
+	std::size_t operator()(std::uint64_t key) const {
+		return hash_mix(key);
+	}
+};
+
+// Open addressing hash map with linear probing and backward shift deletion, so lookups never
+// allocate and erasing leaves no tombstones. Keys and values must be default constructible and
+// the hash must mix into its low bits, which the point hashes in math_util.h do.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class FlatHashMap {
+public:
+	FlatHashMap() = default;
+
+	explicit FlatHashMap(std::size_t n) {
+		reserve(n);
+	}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return size_;
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size_ == 0;
+	}
+
+	// make room for n entries without rehashing
+	void reserve(std::size_t n) {
+		auto slots = std::bit_ceil(std::max<std::size_t>(8, n + n / 3 + 1));
+		if (slots > slots_.size())
+			rehash(slots);
+	}
+
+	// drop every entry but keep the storage
+	void clear() {
+		std::fill(used_.begin(), used_.end(), 0);
+		size_ = 0;
+	}
+
+	// inserts value constructed from args unless key is present; returns the stored value and whether it is new
+	template <typename... Args>
+	std::pair<Value *, bool> try_emplace(const Key &key, Args &&... args) {
+		if (4 * (size_ + 1) > 3 * slots_.size())
+			rehash(std::max<std::size_t>(8, 2 * slots_.size()));
+		auto i = probe(key);
+		if (used_[i])
+			return {&slots_[i].value, false};
+		used_[i] = 1;
+		slots_[i].key = key;
+		slots_[i].value = Value(std::forward<Args>(args)...);
+		size_++;
+		return {&slots_[i].value, true};
+	}
+
+	Value &operator[](const Key &key) {
+		return *try_emplace(key).first;
+	}
+
+	[[nodiscard]]
+	Value *find(const Key &key) {
+		if (size_ == 0)
+			return nullptr;
+		auto i = probe(key);
+		return used_[i] ? &slots_[i].value : nullptr;
+	}
+
+	[[nodiscard]]
+	const Value *find(const Key &key) const {
+		return const_cast<FlatHashMap *>(this)->find(key);
+	}
+
+	[[nodiscard]]
+	bool contains(const Key &key) const {
+		return find(key) != nullptr;
+	}
+
+	bool erase(const Key &key) {
+		if (size_ == 0)
+			return false;
+		auto i = probe(key);
+		if (!used_[i])
+			return false;
+		// shift later members of the probe chain back into the hole
+		for (auto j = (i + 1) & mask_; used_[j]; j = (j + 1) & mask_) {
+			auto home = Hash{}(slots_[j].key) & mask_;
+			if (((j - home) & mask_) >= ((j - i) & mask_)) {
+				slots_[i] = std::move(slots_[j]);
+				i = j;
+			}
+		}
+		used_[i] = 0;
+		size_--;
+		return true;
+	}
+
+	// calls op(key, value) for every entry in storage order
+	template <typename Op>
+	void for_each(Op &&op) const {
+		for (std::size_t i = 0; i < slots_.size(); i++) {
+			if (used_[i])
+				op(slots_[i].key, slots_[i].value);
+		}
+	}
+
+private:
+	struct Slot {
+		Key key{};
+		[[no_unique_address]] Value value{};
+	};
+
+	// slot holding key, or the empty slot where it would go
+	[[nodiscard]]
+	std::size_t probe(const Key &key) const {
+		assert(!slots_.empty());
+		auto i = Hash{}(key) & mask_;
+		while (used_[i] && !Equal{}(slots_[i].key, key))
+			i = (i + 1) & mask_;
+		return i;
+	}
+
+	void rehash(std::size_t slots) {
+		std::vector<Slot> old_slots(slots);
+		std::vector<std::uint8_t> old_used(slots, 0);
+		old_slots.swap(slots_);
+		old_used.swap(used_);
+		mask_ = slots - 1;
+		for (std::size_t i = 0; i < old_slots.size(); i++) {
+			if (!old_used[i])
+				continue;
+			auto j = probe(old_slots[i].key);
+			used_[j] = 1;
+			slots_[j] = std::move(old_slots[i]);
+		}
+	}
+
+	std::vector<Slot> slots_;
+	std::vector<std::uint8_t> used_;
+	std::size_t size_{0};
+	std::size_t mask_{0};
+};
+
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class FlatHashSet {
+public:
+	FlatHashSet() = default;
+
+	explicit FlatHashSet(std::size_t n) : map_(n) {}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return map_.size();
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return map_.empty();
+	}
+
+	void reserve(std::size_t n) {
+		map_.reserve(n);
+	}
+
+	void clear() {
+		map_.clear();
+	}
+
+	// true when key was not present yet
+	bool insert(const Key &key) {
+		return map_.try_emplace(key).second;
+	}
+
+	[[nodiscard]]
+	bool contains(const Key &key) const {
+		return map_.contains(key);
+	}
+
+	bool erase(const Key &key) {
+		return map_.erase(key);
+	}
+
+	template <typename Op>
+	void for_each(Op &&op) const {
+		map_.for_each([&](const Key &key, const Empty &) { op(key); });
+	}
+
+private:
+	struct Empty {};
+
+	FlatHashMap<Key, Empty, Hash, Equal> map_;
+};
+
+} // namespace utils::math
+
+#endif //UTILS_FLAT_HASH_H
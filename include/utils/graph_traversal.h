@@ -25,10 +25,13 @@ SOFTWARE.
 #ifndef UTILS_GRAPH_TRAVERSAL_H
 #define UTILS_GRAPH_TRAVERSAL_H
 
+#include <cstdint>
 #include <functional>
 #include <gsl/gsl>
 #include <utils/concepts.h>
+#include <utils/csr_graph.h>
 #include <utils/graph_poly.h>
+#include <vector>
 
 
 using namespace utils::concepts;
@@ -99,6 +102,48 @@ void backward_traverse_list(gsl::not_null<Ptr> tail, std::function<void(Ptr)> op
 	} while(ptr != nullptr);
 }
 
+// breadth first over out edges, op sees each vertex reachable from source once
+inline void traverse_graph(const csr_graph &graph, std::uint32_t source, std::function<void(std::uint32_t)> op) {
+	std::vector<std::uint8_t> visited(graph.vertex_count(), 0);
+	std::vector<std::uint32_t> layer{source};
+	visited[source] = 1;
+	while(!layer.empty()) {
+		std::vector<std::uint32_t> next_layer{};
+		for(auto v: layer) {
+			op(v);
+			for(auto n: graph.neighbors_of(v)) {
+				if(!visited[n]) {
+					visited[n] = 1;
+					next_layer.push_back(n);
+				}
+			}
+		}
+		layer.swap(next_layer);
+	}
+}
+
+// as traverse_graph, but only the neighbours of vertices for which op returns true are visited
+inline void traverse_graph_with_predicate(const csr_graph &graph, std::uint32_t source,
+                                          std::function<bool(std::uint32_t)> op) {
+	std::vector<std::uint8_t> visited(graph.vertex_count(), 0);
+	std::vector<std::uint32_t> layer{source};
+	visited[source] = 1;
+	while(!layer.empty()) {
+		std::vector<std::uint32_t> next_layer{};
+		for(auto v: layer) {
+			if(!op(v))
+				continue;
+			for(auto n: graph.neighbors_of(v)) {
+				if(!visited[n]) {
+					visited[n] = 1;
+					next_layer.push_back(n);
+				}
+			}
+		}
+		layer.swap(next_layer);
+	}
+}
+
 } // namespace utils::graph
 
 #endif //UTILS_GRAPH_TRAVERSAL_H
@@ -0,0 +1,60 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_JSON_CACHE_H
+#define UTILS_JSON_CACHE_H
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <utils/schema_registry.h>
+
+
+namespace utils::file {
+
+// Binary sidecar cache for json files, off by default. While it is on, write_json_file also writes a CBOR
+// copy next to the file and read_json_file decodes that copy instead of parsing the text, as long as the
+// size, modification time and content hash recorded in its header still match the text file.
+// A missing or stale sidecar is rewritten by the next read.
+void set_json_cache_enabled(bool enabled);
+
+[[nodiscard]]
+bool json_cache_enabled();
+
+[[nodiscard]]
+std::string json_cache_path(const std::string &path);
+
+// the cached document for the file at path whose current contents are text, or nullopt when the sidecar
+// is missing, stale or unreadable
+[[nodiscard]]
+std::optional<json> load_json_cache(const std::string &path, std::span<const std::byte> text);
+
+// writes the sidecar for the file at path holding text, replacing any old one in a single rename;
+// returns false when it could not be written, which only costs the next read its fast path
+bool store_json_cache(const std::string &path, std::span<const std::byte> text, const json &data);
+
+} // namespace utils::file
+
+#endif //UTILS_JSON_CACHE_H
@@ -0,0 +1,75 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_JSON_STREAM_H
+#define UTILS_JSON_STREAM_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utils/schema_registry.h>
+#include <vector>
+
+
+namespace utils::file {
+
+struct json_stream_options {
+	// json pointer to the array or object whose elements are the records, "" for the root
+	std::string records;
+	// json pointers relative to a record; when any are given only these parts of each record are kept
+	// and the rest is skipped by the parser without being built. Arrays on the way to a field keep the
+	// positions of their elements, with null for the ones left out.
+	std::vector<std::string> fields;
+	// when set every record is checked against it in full before the fields are picked out
+	std::shared_ptr<const SchemaRegistry::Validator> validator;
+};
+
+struct json_record {
+	// position in the records container
+	std::size_t index;
+	// member name when the records container is an object, empty for an array
+	std::string key;
+	json value;
+	validation_result validation;
+};
+
+// return false to stop reading
+using json_record_callback = std::function<bool(json_record &)>;
+
+// Streams the records of a document through callback one at a time, so memory is bounded by the
+// largest record instead of the document. Returns how many records were delivered; throws
+// runtime_error for an unreadable file or malformed json.
+std::size_t stream_json_records(std::string_view text,
+                                const json_stream_options &options,
+                                const json_record_callback &callback);
+
+std::size_t stream_json_file(const std::string &path,
+                             const json_stream_options &options,
+                             const json_record_callback &callback);
+
+} // namespace utils::file
+
+#endif //UTILS_JSON_STREAM_H
@@ -0,0 +1,103 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+
+namespace utils::file {
+
+// hint for how the bytes of a mapped file will be read
+enum class access_pattern {
+	normal,
+	sequential,
+	random
+};
+
+// Read-only view of a whole file, mapped into memory when the platform and file allow it and
+// otherwise read into one buffer with a single sized read. The bytes are valid while the object lives.
+class MappedFile {
+public:
+	MappedFile() = default;
+
+	// throws runtime_error when the file cannot be opened or read
+	explicit MappedFile(const std::string &path, access_pattern pattern = access_pattern::normal);
+
+	MappedFile(const MappedFile &) = delete;
+
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	MappedFile(MappedFile &&other) noexcept;
+
+	MappedFile &operator=(MappedFile &&other) noexcept;
+
+	~MappedFile();
+
+	// passes the hint on to the kernel, does nothing for a file that was read instead of mapped
+	void advise(access_pattern pattern) const;
+
+	[[nodiscard]]
+	std::span<const std::byte> bytes() const {
+		return {data_, size_};
+	}
+
+	[[nodiscard]]
+	std::string_view view() const {
+		return {reinterpret_cast<const char *>(data_), size_};
+	}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return size_;
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size_ == 0;
+	}
+
+	// false when the contents were read into a buffer
+	[[nodiscard]]
+	bool mapped() const {
+		return mapped_;
+	}
+
+private:
+	void release();
+
+	const std::byte *data_{nullptr};
+	std::size_t size_{0};
+	bool mapped_{false};
+	std::unique_ptr<std::byte[]> buffer_;
+};
+
+} // namespace utils::file
+
+#endif //UTILS_MAPPED_FILE_H
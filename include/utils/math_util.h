@@ -29,11 +29,13 @@ SOFTWARE.
 #include <CGAL/point_generators_2.h>
 #include <CGAL/Orthogonal_k_neighbor_search.h>
 #include <CGAL/Search_traits_2.h>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <list>
-#include <fmt/format.h>
 #include <functional>
 #include <glm/glm.hpp>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -54,18 +56,28 @@ struct bounds {
 [[nodiscard]]
 std::vector<Point_2> query_closest(const std::vector<Point_2> &points, const Point_2 &query, const std::size_t n = 1);
 
+// distinct integer points in [0, width) x [0, height), see point_generators.h for other distributions
 std::vector<Point_2> generate_points(unsigned int num_points, unsigned int width, unsigned int height);
 
+std::vector<Point_2> generate_points(unsigned int num_points, unsigned int width, unsigned int height,
+                                     std::uint64_t seed);
+
 std::vector<Point_2> convert_to_point_2(const std::vector<double> &coords);
 
+// uniform in [a, b) from this thread's generator, see random.h for bulk fills
 float uniform_random(float a = 0.f, float b = 1.f);
 
+// exact for n <= 33, see binomial.h for 64-bit and floating point versions
 int binomial_coeff(int n, int k);
 
 double compute_parabola_y(glm::vec2 focus, double directrix_y, double x);
 
+double compute_parabola_y(glm::dvec2 focus, double directrix_y, double x);
+
 double compute_parabolic_collision_x(glm::vec2 left, glm::vec2 right, double directrix_y);
 
+double compute_parabolic_collision_x(glm::dvec2 left, glm::dvec2 right, double directrix_y);
+
 bool in_rect(glm::vec2 p, rect r);
 
 bool in_rect(Point_2 p, rect r);
@@ -78,6 +90,15 @@ bool in_bounds(Point_2 p, bounds b);
 
 bool in_bounds(double x, double y, bounds b);
 
+// batch tests over coordinate arrays: mask[i] is set to 1 when (xs[i], ys[i]) is inside, returns the hit count
+std::size_t in_rect(std::span<const double> xs, std::span<const double> ys, rect r, std::span<std::uint8_t> mask);
+
+std::size_t in_rect(std::span<const float> xs, std::span<const float> ys, rect r, std::span<std::uint8_t> mask);
+
+std::size_t in_bounds(std::span<const double> xs, std::span<const double> ys, bounds b, std::span<std::uint8_t> mask);
+
+std::size_t in_bounds(std::span<const float> xs, std::span<const float> ys, bounds b, std::span<std::uint8_t> mask);
+
 bool check_overflow(double val);
 
 bool check_overflow(float val);
@@ -88,16 +109,45 @@ int orientation(glm::vec2 p, glm::vec2 q, glm::vec2 r);
 
 bool do_intersect(glm::vec2 p1, glm::vec2 q1, glm::vec2 p2, glm::vec2 q2);
 
+// (q - p) x (r - p) with an exact sign: > 0 counterclockwise, < 0 clockwise, 0 colinear
+double orient2d(glm::dvec2 p, glm::dvec2 q, glm::dvec2 r);
+
+// (a1 - a0) x (b1 - b0) with an exact sign, used to compare directions of two segments
+double cross2d(glm::dvec2 a0, glm::dvec2 a1, glm::dvec2 b0, glm::dvec2 b1);
+
 glm::vec2 compute_triangle_circumcenter(glm::vec2 a, glm::vec2 b, glm::vec2 c);
 
+glm::dvec2 compute_triangle_circumcenter(glm::dvec2 a, glm::dvec2 b, glm::dvec2 c);
+
+// Span overloads below read their inputs in place and write into caller-owned buffers that need at
+// least the matching *_size() elements; they return how many elements were written.
+
 /* 2-D utils */
 std::vector<glm::vec2> generate_bezier_curve(std::vector<glm::vec2> control_points, double step_size);
 
+std::size_t generate_bezier_curve(std::span<const glm::vec2> control_points, double step_size,
+                                  std::span<glm::vec2> out);
+
+// points generate_bezier_curve returns for a glm curve with this many control points
+std::size_t bezier_curve_size(std::size_t control_points, double step_size);
+
+// fewest vertices that stay within tolerance of the curve, see flatten_bezier_curve in bezier.h
+std::vector<glm::vec2> flatten_bezier_curve(const std::vector<glm::vec2> &control_points, double tolerance);
+
 std::vector<double> generate_parabola(std::vector<double> x, double a = 1, double b = 0, double c = 0);
 
+// y needs x.size() elements
+std::size_t generate_parabola(std::span<const double> x, std::span<double> y, double a = 1, double b = 0, double c = 0);
+
 /* 3-D utils */
 std::vector<glm::vec3> generate_bezier_curve(std::vector<glm::vec3> control_points, double step_size);
 
+std::size_t generate_bezier_curve(std::span<const glm::vec3> control_points, double step_size,
+                                  std::span<glm::vec3> out);
+
+std::vector<glm::vec3> flatten_bezier_curve(const std::vector<glm::vec3> &control_points, double tolerance);
+
+// point samples only, see mesh.h for indexed meshes with normals and uvs
 std::vector<glm::vec3> generate_sphere(double radius, double phi_step, double theta_step);
 
 std::vector<glm::vec3>
@@ -108,19 +158,65 @@ std::vector<glm::vec3> generate_box(double width, double height, double length);
 
 /* N-D utils */
 std::vector<float> generate_bezier_curve(std::vector<float> control_points, double step_size, int dimension);
-// TODO: int* generate_binomial_matrix(int n, int k);
+
+std::size_t generate_bezier_curve(std::span<const float> control_points, double step_size, int dimension,
+                                  std::span<float> out);
+
+// floats the N-D generate_bezier_curve returns for this many control point values
+std::size_t bezier_curve_size(std::size_t control_values, double step_size, int dimension);
+
+// characteristic matrix of the degree n Bezier, (n + 1) x (n + 1) row major: row i holds the t^i
+// coefficient of every Bernstein polynomial, so [1 t ... t^n] * M * P evaluates control points P
+std::vector<double> generate_binomial_matrix(int n);
 
 // generate bezier curve for given control points
 
 // via polynomial function
 std::vector<float> bezier_polynomial(std::vector<float> points, double step_size, int dimension);
 
+std::size_t bezier_polynomial(std::span<const float> points, double step_size, int dimension, std::span<float> out);
+
+std::size_t bezier_polynomial_size(std::size_t control_values, double step_size, int dimension);
+
 // geometrically
 std::vector<float> bezier_deCasteljau(std::vector<float> points, double step_size, int dimension);
 
+std::size_t bezier_deCasteljau(std::span<const float> points, double step_size, int dimension, std::span<float> out);
+
+std::size_t bezier_deCasteljau_size(std::size_t control_values, double step_size, int dimension);
+
 std::vector<float> deCasteljau_kernel(std::vector<float> points, double t, int dimension);
-// via matrix operations
-// TODO: std::vector<float> bezier_matrix(std::vector<float> control_points, double step_size, int dimension);
+// via matrix operations: the power basis sampled at every t times the characteristic matrix is the
+// Bernstein weight table generate_bezier_curve caches per degree and step size, leaving one small GEMM
+// per curve. Samples like generate_bezier_curve.
+std::vector<float> bezier_matrix(std::vector<float> control_points, double step_size, int dimension);
+
+// curves of the same degree back to back in control_points, all evaluated against one cached basis
+std::vector<float> bezier_matrix(const std::vector<float> &control_points, std::size_t curves, double step_size,
+                                 int dimension);
+} // namespace utils::math
+
+namespace utils::math {
+
+// splitmix64 finalizer, spreads every input bit over the whole word
+constexpr std::uint64_t hash_mix(std::uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+// bit patterns with -0.0 folded into 0.0 so values that compare equal hash equally
+inline std::uint32_t hash_bits(float val) {
+	return std::bit_cast<std::uint32_t>(val == 0.0f ? 0.0f : val);
+}
+
+inline std::uint64_t hash_bits(double val) {
+	return std::bit_cast<std::uint64_t>(val == 0.0 ? 0.0 : val);
+}
+
 } // namespace utils::math
 
 namespace std {
@@ -128,21 +224,24 @@ namespace std {
 template <>
 struct hash<glm::vec2> {
 	size_t operator()(const glm::vec2& p) const {
-		return hash<std::string>()(fmt::format("{}:{}", p.x, p.y));
+		using namespace utils::math;
+		return hash_mix(std::uint64_t{hash_bits(p.x)} << 32 | hash_bits(p.y));
 	}
 };
 
 template <>
 struct hash<glm::vec3> {
 	size_t operator()(const glm::vec3& p) const {
-		return hash<std::string>()(fmt::format("{}:{}:{}", p.x, p.y, p.z));
+		using namespace utils::math;
+		return hash_mix(hash_mix(std::uint64_t{hash_bits(p.x)} << 32 | hash_bits(p.y)) ^ hash_bits(p.z));
 	}
 };
 
 template <>
 struct hash<CGAL::Simple_cartesian<double>::Point_2> {
 	size_t operator()(const CGAL::Simple_cartesian<double>::Point_2& p) const {
-		return hash<string>()(fmt::format("{}:{}", p.x(), p.y()));
+		using namespace utils::math;
+		return hash_mix(hash_mix(hash_bits(p.x())) ^ hash_bits(p.y()));
 	}
 };
 
@@ -0,0 +1,97 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_MESH_H
+#define UTILS_MESH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+
+namespace utils::math {
+
+// optional vertex attributes, or-ed together
+enum mesh_attribute : unsigned int {
+	mesh_normals = 1u << 0,
+	mesh_uvs = 1u << 1,
+};
+
+struct mesh_size {
+	std::size_t vertices;
+	std::size_t indices;
+};
+
+// caller-owned output buffers; normals and uvs are written only when not empty
+struct mesh_view {
+	std::span<glm::vec3> positions;
+	std::span<glm::vec3> normals;
+	std::span<glm::vec2> uvs;
+	std::span<std::uint32_t> indices;
+};
+
+struct indexed_mesh {
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<std::uint32_t> indices;
+
+	mesh_view view() {
+		return {positions, normals, uvs, indices};
+	}
+};
+
+// Triangle meshes wound counterclockwise seen from outside. A vertex is shared by every
+// face that agrees on all requested attributes, so the plain position meshes are fully
+// deduplicated while uvs add a seam and normals split the hard edges of caps and boxes.
+// Each generator needs buffers of exactly the size reported for the same attributes.
+
+// sphere around the origin, z up; stacks run pole to pole, needs slices >= 3, stacks >= 2
+mesh_size sphere_mesh_size(unsigned int slices, unsigned int stacks, unsigned int attributes = 0);
+
+void generate_sphere_mesh(double radius, unsigned int slices, unsigned int stacks, mesh_view out);
+
+indexed_mesh generate_sphere_mesh(double radius, unsigned int slices, unsigned int stacks,
+                                  unsigned int attributes = 0);
+
+// closed cylinder along z from 0 to length, needs slices >= 3, stacks >= 1
+mesh_size cylinder_mesh_size(unsigned int slices, unsigned int stacks, unsigned int attributes = 0);
+
+void generate_cylinder_mesh(double radius, double length, unsigned int slices, unsigned int stacks, mesh_view out);
+
+indexed_mesh generate_cylinder_mesh(double radius, double length, unsigned int slices, unsigned int stacks,
+                                    unsigned int attributes = 0);
+
+// box spanning (0, 0, 0) to (width, height, length), same corners as generate_box
+mesh_size box_mesh_size(unsigned int attributes = 0);
+
+void generate_box_mesh(double width, double height, double length, mesh_view out);
+
+indexed_mesh generate_box_mesh(double width, double height, double length, unsigned int attributes = 0);
+
+} // namespace utils::math
+
+#endif //UTILS_MESH_H
@@ -0,0 +1,224 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_POINT_CLOUD_H
+#define UTILS_POINT_CLOUD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <utils/math_util.h>
+#include <vector>
+
+
+namespace utils::math {
+
+struct bounds_3 {
+	glm::vec3 min;
+	glm::vec3 max;
+};
+
+// Point sets stored as one float array per coordinate so bulk passes stream through
+// contiguous memory and vectorize. xs()/ys()/zs() are plain spans over that storage and
+// can be passed straight to the span overloads in math_util.h without copying.
+class PointCloud2D {
+public:
+	PointCloud2D() = default;
+
+	explicit PointCloud2D(std::size_t size);
+
+	explicit PointCloud2D(std::span<const glm::vec2> points);
+
+	explicit PointCloud2D(std::span<const Point_2> points);
+
+	void resize(std::size_t size);
+
+	void reserve(std::size_t size);
+
+	void clear();
+
+	void push_back(glm::vec2 point);
+
+	[[nodiscard]]
+	glm::vec2 operator[](std::size_t i) const {
+		return {xs_[i], ys_[i]};
+	}
+
+	void set(std::size_t i, glm::vec2 point) {
+		xs_[i] = point.x;
+		ys_[i] = point.y;
+	}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return xs_.size();
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return xs_.empty();
+	}
+
+	std::span<float> xs() {
+		return xs_;
+	}
+
+	std::span<float> ys() {
+		return ys_;
+	}
+
+	[[nodiscard]]
+	std::span<const float> xs() const {
+		return xs_;
+	}
+
+	[[nodiscard]]
+	std::span<const float> ys() const {
+		return ys_;
+	}
+
+	// smallest box holding every point, bottom_right included; inverted and infinite when empty
+	[[nodiscard]]
+	bounds bounding_box() const;
+
+	[[nodiscard]]
+	glm::vec2 centroid() const;
+
+	// applies an affine transform given in homogeneous coordinates
+	void transform(const glm::mat3 &m);
+
+	void translate(glm::vec2 offset);
+
+	void scale(glm::vec2 factor);
+
+	// same half-open tests as the batch in_rect/in_bounds in math_util.h
+	std::size_t in_rect(rect r, std::span<std::uint8_t> mask) const;
+
+	std::size_t in_bounds(bounds b, std::span<std::uint8_t> mask) const;
+
+	[[nodiscard]]
+	std::vector<glm::vec2> to_vec2() const;
+
+	[[nodiscard]]
+	std::vector<Point_2> to_point_2() const;
+
+private:
+	std::vector<float> xs_;
+	std::vector<float> ys_;
+};
+
+class PointCloud3D {
+public:
+	PointCloud3D() = default;
+
+	explicit PointCloud3D(std::size_t size);
+
+	explicit PointCloud3D(std::span<const glm::vec3> points);
+
+	void resize(std::size_t size);
+
+	void reserve(std::size_t size);
+
+	void clear();
+
+	void push_back(glm::vec3 point);
+
+	[[nodiscard]]
+	glm::vec3 operator[](std::size_t i) const {
+		return {xs_[i], ys_[i], zs_[i]};
+	}
+
+	void set(std::size_t i, glm::vec3 point) {
+		xs_[i] = point.x;
+		ys_[i] = point.y;
+		zs_[i] = point.z;
+	}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return xs_.size();
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return xs_.empty();
+	}
+
+	std::span<float> xs() {
+		return xs_;
+	}
+
+	std::span<float> ys() {
+		return ys_;
+	}
+
+	std::span<float> zs() {
+		return zs_;
+	}
+
+	[[nodiscard]]
+	std::span<const float> xs() const {
+		return xs_;
+	}
+
+	[[nodiscard]]
+	std::span<const float> ys() const {
+		return ys_;
+	}
+
+	[[nodiscard]]
+	std::span<const float> zs() const {
+		return zs_;
+	}
+
+	// smallest box holding every point, max included; inverted and infinite when empty
+	[[nodiscard]]
+	bounds_3 bounding_box() const;
+
+	[[nodiscard]]
+	glm::vec3 centroid() const;
+
+	// applies an affine transform given in homogeneous coordinates, the last row is ignored
+	void transform(const glm::mat4 &m);
+
+	void translate(glm::vec3 offset);
+
+	void scale(glm::vec3 factor);
+
+	// mask[i] is set to 1 when point i lies in [min, max), returns the hit count
+	std::size_t in_bounds(bounds_3 b, std::span<std::uint8_t> mask) const;
+
+	[[nodiscard]]
+	std::vector<glm::vec3> to_vec3() const;
+
+private:
+	std::vector<float> xs_;
+	std::vector<float> ys_;
+	std::vector<float> zs_;
+};
+
+} // namespace utils::math
+
+#endif //UTILS_POINT_CLOUD_H
@@ -0,0 +1,55 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_POINT_GENERATORS_H
+#define UTILS_POINT_GENERATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utils/math_util.h>
+#include <vector>
+
+
+namespace utils::math {
+
+// fills out with points uniformly distributed over [0, width) x [0, height)
+void generate_uniform_points(std::span<Point_2> out, double width, double height, std::uint64_t seed);
+
+// fills out with distinct integer points from [0, width) x [0, height), needs out.size() <= width * height
+void generate_lattice_points(std::span<Point_2> out, unsigned int width, unsigned int height, std::uint64_t seed);
+
+// one point per cell of a cols x rows grid over [0, width) x [0, height), moved off the cell center by
+// up to jitter (0 to 1) of the cell size; needs out.size() == cols * rows
+void generate_jittered_grid(std::span<Point_2> out, unsigned int cols, unsigned int rows,
+                            double width, double height, double jitter, std::uint64_t seed);
+
+// Bridson's Poisson-disk (blue noise) sampling: points at least min_distance apart, appended to out.
+// Returns how many were added, none for an empty area.
+std::size_t generate_poisson_disk(std::vector<Point_2> &out, double width, double height, double min_distance,
+                                  std::uint64_t seed, unsigned int attempts = 30);
+
+} // namespace utils::math
+
+#endif //UTILS_POINT_GENERATORS_H
@@ -0,0 +1,146 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_POINT_INDEX_H
+#define UTILS_POINT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utils/csr_graph.h>
+#include <utils/math_util.h>
+#include <utils/thread_pool.h>
+#include <vector>
+
+
+namespace utils::math {
+
+// k-d tree over a 2-D point set that is built once and queried many times.
+// Points added with insert() are scanned linearly until enough of them pile up to rebuild.
+class PointIndex2D {
+public:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	PointIndex2D() = default;
+
+	explicit PointIndex2D(std::vector<Point_2> points);
+
+	void rebuild(std::vector<Point_2> points);
+
+	void rebuild();
+
+	std::size_t insert(const Point_2 &point);
+
+	void reserve(std::size_t n);
+
+	void clear();
+
+	[[nodiscard]]
+	std::vector<Point_2> query_closest(const Point_2 &query, std::size_t n = 1) const;
+
+	// fills indices/sq_distances with up to indices.size() nearest points, closest first
+	std::size_t query_closest(const Point_2 &query,
+	                          std::span<std::size_t> indices,
+	                          std::span<double> sq_distances) const;
+
+	// append the indices of every point inside the region to out, returns how many were added
+	std::size_t query_range(rect r, std::vector<std::size_t> &out) const;
+
+	std::size_t query_range(bounds b, std::vector<std::size_t> &out) const;
+
+	std::size_t query_radius(const Point_2 &center, double radius, std::vector<std::size_t> &out) const;
+
+	[[nodiscard]]
+	const Point_2 &operator[](std::size_t i) const {
+		return points_[i];
+	}
+
+	[[nodiscard]]
+	const std::vector<Point_2> &points() const {
+		return points_;
+	}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return points_.size();
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return points_.empty();
+	}
+
+private:
+	static constexpr std::uint32_t leaf_size = 16;
+
+	struct Node {
+		double min_x, min_y, max_x, max_y;
+		std::uint32_t begin, end;
+		// child node ids, 0 for leaves (the root is never a child)
+		std::uint32_t left, right;
+	};
+
+	std::uint32_t build(std::uint32_t begin, std::uint32_t end);
+
+	template <typename Region>
+	std::size_t query_region(const Region &region, std::vector<std::size_t> &out) const;
+
+	std::vector<Point_2> points_;
+	std::vector<Node> nodes_;
+	// tree order -> position in points_, with coordinates stored alongside for leaf scans
+	std::vector<std::uint32_t> order_;
+	std::vector<double> xs_;
+	std::vector<double> ys_;
+	// points_[0, indexed_) are in the tree, the rest are pending a rebuild
+	std::size_t indexed_{0};
+};
+
+[[nodiscard]]
+std::vector<Point_2> query_closest(const PointIndex2D &index, const Point_2 &query, std::size_t n = 1);
+
+// k nearest neighbours of every query, written row-major into buffers of queries.size() * k entries.
+// Rows are padded with PointIndex2D::npos and infinity when the index holds fewer than k points.
+void query_closest(const PointIndex2D &index,
+                   std::span<const Point_2> queries,
+                   std::size_t k,
+                   std::span<std::size_t> indices,
+                   std::span<double> sq_distances,
+                   parallel::ThreadPool &pool = parallel::ThreadPool::global());
+
+// directed k nearest neighbour graph: every point links to its min(k, n - 1) closest other points,
+// closest first, weighted by distance. The index is built once and the queries run on pool.
+[[nodiscard]]
+graph::csr_graph build_knn_graph(std::span<const Point_2> points,
+                                 std::size_t k,
+                                 parallel::ThreadPool &pool = parallel::ThreadPool::global());
+
+[[nodiscard]]
+graph::csr_graph build_knn_graph(const PointIndex2D &index,
+                                 std::size_t k,
+                                 parallel::ThreadPool &pool = parallel::ThreadPool::global());
+
+} // namespace utils::math
+
+#endif //UTILS_POINT_INDEX_H
@@ -0,0 +1,137 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_RANDOM_H
+#define UTILS_RANDOM_H
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+
+namespace utils::random {
+
+// advances state and returns the next splitmix64 output, used to expand seeds
+constexpr std::uint64_t splitmix64(std::uint64_t &state) {
+	std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+// xoshiro256** (Blackman & Vigna): small, fast and seedable, usable with the <random> distributions
+class Xoshiro256 {
+public:
+	using result_type = std::uint64_t;
+
+	explicit Xoshiro256(std::uint64_t seed = 0) {
+		this->seed(seed);
+	}
+
+	void seed(std::uint64_t seed) {
+		for (auto &s: state_)
+			s = splitmix64(seed);
+	}
+
+	static constexpr result_type min() {
+		return 0;
+	}
+
+	static constexpr result_type max() {
+		return std::numeric_limits<result_type>::max();
+	}
+
+	result_type operator()() {
+		const auto result = rotl(state_[1] * 5, 7) * 9;
+		const auto t = state_[1] << 17;
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+		state_[2] ^= t;
+		state_[3] = rotl(state_[3], 45);
+		return result;
+	}
+
+	// uniform in [0, 1)
+	double next_double() {
+		return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+	}
+
+	float next_float() {
+		return static_cast<float>((*this)() >> 40) * 0x1.0p-24f;
+	}
+
+	// uniform in [0, bound) without modulo bias (Lemire's multiply and reject)
+	std::uint64_t next_below(std::uint64_t bound) {
+		auto m = static_cast<unsigned __int128>((*this)()) * bound;
+		auto low = static_cast<std::uint64_t>(m);
+		if (low < bound) {
+			const auto threshold = -bound % bound;
+			while (low < threshold) {
+				m = static_cast<unsigned __int128>((*this)()) * bound;
+				low = static_cast<std::uint64_t>(m);
+			}
+		}
+		return static_cast<std::uint64_t>(m >> 64);
+	}
+
+private:
+	static constexpr std::uint64_t rotl(std::uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	std::uint64_t state_[4];
+};
+
+// this thread's generator, seeded on first use from one process wide random seed plus a stream
+// number per thread, so worker threads never share or lock generator state
+Xoshiro256 &thread_generator();
+
+// reseeds this thread's generator, for reproducible runs
+void seed_thread_generator(std::uint64_t seed);
+
+// Bulk fills. Large spans run 32 interleaved xoshiro256** streams seeded from rng so the inner
+// loops vectorize; the output is deterministic for a given rng state.
+
+// raw 64-bit outputs
+void fill_bits(std::span<std::uint64_t> out, Xoshiro256 &rng = thread_generator());
+
+// uniform in [a, b)
+void fill_uniform(std::span<float> out, float a, float b, Xoshiro256 &rng = thread_generator());
+
+void fill_uniform(std::span<double> out, double a, double b, Xoshiro256 &rng = thread_generator());
+
+// normally distributed (Box-Muller)
+void fill_normal(std::span<float> out, float mean, float stddev, Xoshiro256 &rng = thread_generator());
+
+void fill_normal(std::span<double> out, double mean, double stddev, Xoshiro256 &rng = thread_generator());
+
+// uniform integers in [lo, hi], both ends included, without modulo bias
+void fill_uniform_int(std::span<std::int32_t> out, std::int32_t lo, std::int32_t hi,
+                      Xoshiro256 &rng = thread_generator());
+
+} // namespace utils::random
+
+#endif //UTILS_RANDOM_H
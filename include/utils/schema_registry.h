@@ -0,0 +1,95 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_SCHEMA_REGISTRY_H
+#define UTILS_SCHEMA_REGISTRY_H
+
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <nlohmann/json-schema.hpp>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace utils::file {
+
+using json = nlohmann::json;
+
+// one failed constraint
+struct validation_error {
+	// json pointer to the offending value in the instance, "" for the root
+	std::string pointer;
+	std::string message;
+};
+
+struct validation_result {
+	std::vector<validation_error> errors;
+
+	[[nodiscard]]
+	bool valid() const {
+		return errors.empty();
+	}
+};
+
+// Compiles every schema once and shares the compiled validator between calls and threads.
+// Schemas with a string "$id" are keyed by it, the first schema seen for an id wins;
+// any other schema is keyed by its content.
+class SchemaRegistry {
+public:
+	using Validator = nlohmann::json_schema::json_validator;
+
+	// process wide registry used by read_json_file
+	static SchemaRegistry &global();
+
+	// the compiled validator for schema, compiling it on first use; throws runtime_error if it does not compile
+	std::shared_ptr<const Validator> compile(const json &schema);
+
+	// the validator registered under id, or nullptr
+	[[nodiscard]]
+	std::shared_ptr<const Validator> find(const std::string &id) const;
+
+	// every failed constraint of data, rather than stopping at the first
+	validation_result validate(const json &data, const json &schema);
+
+	// against the schema compiled with that $id; throws runtime_error when there is none
+	validation_result validate_id(const json &data, const std::string &id) const;
+
+	static validation_result validate(const json &data, const Validator &validator);
+
+	[[nodiscard]]
+	std::size_t size() const;
+
+	void clear();
+
+private:
+	mutable std::shared_mutex mutex_;
+	std::unordered_map<std::string, std::shared_ptr<const Validator>> by_id_;
+	std::unordered_map<json, std::shared_ptr<const Validator>> by_content_;
+};
+
+} // namespace utils::file
+
+#endif //UTILS_SCHEMA_REGISTRY_H
@@ -0,0 +1,56 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_SEGMENT_INTERSECTION_H
+#define UTILS_SEGMENT_INTERSECTION_H
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+
+namespace utils::math {
+
+struct line_segment {
+	glm::dvec2 start;
+	glm::dvec2 end;
+};
+
+struct segment_intersection {
+	// input indices, first < second
+	std::size_t first;
+	std::size_t second;
+	// leftmost shared point; the start of the overlap for colinear segments
+	glm::dvec2 point;
+};
+
+// Bentley-Ottmann sweep reporting every intersecting pair once in O((n + k) log n).
+// Whether two segments touch is decided with the exact orient2d predicate, so shared
+// endpoints, T-junctions, colinear overlaps and zero-length segments are all reported.
+std::vector<segment_intersection> find_segment_intersections(std::span<const line_segment> segments);
+
+} // namespace utils::math
+
+#endif //UTILS_SEGMENT_INTERSECTION_H
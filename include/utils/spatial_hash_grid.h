@@ -0,0 +1,178 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_SPATIAL_HASH_GRID_H
+#define UTILS_SPATIAL_HASH_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utils/flat_hash.h>
+#include <utils/math_util.h>
+#include <utils/thread_pool.h>
+#include <vector>
+
+
+namespace utils::math {
+
+// Uniform grid over moving 2-D points, hashed by cell so the plane is unbounded.
+// Each point keeps the id insert() gave it until it is removed; insert, remove and move are O(1).
+// Cells own runs of one shared entry array holding coordinates alongside the ids, and
+// rebuild() refills every run from scratch, which is the cheap path when most points move per tick.
+class SpatialHashGrid2D {
+public:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	explicit SpatialHashGrid2D(double cell_size);
+
+	// replaces the contents, point i gets id i; cells and coordinates are computed on pool
+	void rebuild(std::span<const Point_2> points, parallel::ThreadPool &pool = parallel::ThreadPool::global());
+
+	void rebuild(std::span<const glm::vec2> points, parallel::ThreadPool &pool = parallel::ThreadPool::global());
+
+	std::size_t insert(const Point_2 &point);
+
+	std::size_t insert(glm::vec2 point);
+
+	void remove(std::size_t id);
+
+	void move(std::size_t id, const Point_2 &point);
+
+	void move(std::size_t id, glm::vec2 point);
+
+	void clear();
+
+	// closes the gaps left by cells that outgrew or emptied their run and drops empty cells; runs on its own
+	// once the gaps outnumber the points
+	void compact();
+
+	// fills indices/sq_distances with the ids of up to indices.size() nearest points, closest first
+	std::size_t query_closest(const Point_2 &query,
+	                          std::span<std::size_t> indices,
+	                          std::span<double> sq_distances) const;
+
+	// append the ids of every point inside the region to out, returns how many were added
+	std::size_t query_range(rect r, std::vector<std::size_t> &out) const;
+
+	std::size_t query_range(bounds b, std::vector<std::size_t> &out) const;
+
+	std::size_t query_radius(const Point_2 &center, double radius, std::vector<std::size_t> &out) const;
+
+	[[nodiscard]]
+	Point_2 operator[](std::size_t id) const {
+		return {xs_[slots_[id]], ys_[slots_[id]]};
+	}
+
+	[[nodiscard]]
+	bool contains(std::size_t id) const {
+		return id < cell_of_.size() && cell_of_[id] != no_cell;
+	}
+
+	[[nodiscard]]
+	double cell_size() const {
+		return cell_size_;
+	}
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return size_;
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size_ == 0;
+	}
+
+private:
+	static constexpr std::uint32_t no_cell = std::numeric_limits<std::uint32_t>::max();
+
+	struct Cell {
+		std::uint64_t key;
+		// run of entries owned by the cell, the first size of them in use; empty cells own none
+		std::uint32_t begin, size, capacity;
+	};
+
+	template <typename Point>
+	void rebuild_points(std::span<const Point> points, parallel::ThreadPool &pool);
+
+	[[nodiscard]]
+	std::int32_t cell_coord(double v) const;
+
+	[[nodiscard]]
+	std::uint64_t cell_key(double x, double y) const;
+
+	std::uint32_t find_or_add_cell(std::uint64_t key);
+
+	void grow(std::uint32_t cell);
+
+	void place(std::uint32_t id, double x, double y);
+
+	void unlink(std::uint32_t id);
+
+	void move_to(std::uint32_t id, double x, double y);
+
+	std::size_t new_id();
+
+	void reset_extent();
+
+	// calls visit(cell) for every occupied cell meeting the cell coordinate box
+	template <typename Visit>
+	void for_each_cell(std::int64_t x0, std::int64_t y0, std::int64_t x1, std::int64_t y1, Visit &&visit) const;
+
+	template <typename Contains>
+	std::size_t query_box(double x0, double y0, double x1, double y1, Contains &&contains,
+	                      std::vector<std::size_t> &out) const;
+
+	double cell_size_;
+	double inv_cell_size_;
+	std::vector<Cell> cells_;
+	FlatHashMap<std::uint64_t, std::uint32_t, MixHash> cell_index_;
+	// entries, in runs per cell
+	std::vector<std::uint32_t> ids_;
+	std::vector<double> xs_;
+	std::vector<double> ys_;
+	// per id: owning cell and entry position
+	std::vector<std::uint32_t> cell_of_;
+	std::vector<std::uint32_t> slots_;
+	std::vector<std::uint32_t> free_ids_;
+	std::size_t size_{0};
+	// entries lost to cells that moved or gave up their run
+	std::size_t holes_{0};
+	// cell coordinates of every cell created since the last rebuild, clear or compact
+	std::int32_t min_cx_, min_cy_, max_cx_, max_cy_;
+};
+
+// k nearest neighbours of every query, written row-major into buffers of queries.size() * k entries.
+// Rows are padded with SpatialHashGrid2D::npos and infinity when the grid holds fewer than k points.
+void query_closest(const SpatialHashGrid2D &grid,
+                   std::span<const Point_2> queries,
+                   std::size_t k,
+                   std::span<std::size_t> indices,
+                   std::span<double> sq_distances,
+                   parallel::ThreadPool &pool = parallel::ThreadPool::global());
+
+} // namespace utils::math
+
+#endif //UTILS_SPATIAL_HASH_GRID_H
@@ -25,13 +25,50 @@ SOFTWARE.
 #ifndef UTILS_STRING_UTIL_H
 #define UTILS_STRING_UTIL_H
 
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utils/random.h>
 
 
 namespace utils::string {
 
+// 128-bit uuid stored as its 16 bytes, in the order they appear in the text form
+struct Uuid {
+	// 8-4-4-4-12 hex digits
+	static constexpr std::size_t string_size = 36;
+
+	std::array<std::uint8_t, 16> bytes{};
+
+	// writes string_size lowercase characters, no terminator
+	void to_chars(char *out) const;
+
+	[[nodiscard]] std::string to_string() const;
+
+	// the 8-4-4-4-12 form in either case, std::nullopt for anything else
+	static std::optional<Uuid> parse(std::string_view text);
+
+	friend auto operator<=>(const Uuid &, const Uuid &) = default;
+};
+
+// random version 4 uuids, two generator outputs each and no per id allocation
+void generate_uuid4(std::span<Uuid> out, random::Xoshiro256 &rng = random::thread_generator());
+
+Uuid generate_uuid4(random::Xoshiro256 &rng = random::thread_generator());
+
 std::string uuid4();
 
 } // namespace utils::string
 
+template <>
+struct std::hash<utils::string::Uuid> {
+	std::size_t operator()(const utils::string::Uuid &uuid) const noexcept;
+};
+
 #endif //UTILS_STRING_UTIL_H
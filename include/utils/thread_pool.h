@@ -0,0 +1,91 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace utils::parallel {
+
+// Work-stealing pool: every worker owns a deque, runs its own tasks newest first and steals the
+// oldest task of another worker when it runs dry. Tasks submitted from a worker go to its own deque.
+class ThreadPool {
+public:
+	explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+
+	ThreadPool(const ThreadPool &) = delete;
+
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	~ThreadPool();
+
+	// process wide pool sized to the hardware
+	static ThreadPool &global();
+
+	[[nodiscard]]
+	std::size_t size() const {
+		return workers_.size();
+	}
+
+	void submit(std::function<void()> task);
+
+	// calls op(begin, end) over [0, count) in chunks of grain (the last may be shorter) and blocks until
+	// all are done.
+	// The calling thread takes chunks as well, so this is safe to nest inside pool tasks.
+	void parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)> &op);
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	void work(std::size_t index);
+
+	// own deque from the back, then the others from the front
+	bool take(std::size_t index, std::function<void()> &task);
+
+	std::vector<std::thread> workers_;
+	std::vector<std::unique_ptr<Queue>> queues_;
+	std::atomic<std::size_t> next_queue_{0};
+	// submitted but not yet taken, guards sleeping
+	std::atomic<std::ptrdiff_t> pending_{0};
+	std::mutex mutex_;
+	std::condition_variable available_;
+	bool stopping_{false};
+};
+
+} // namespace utils::parallel
+
+#endif //UTILS_THREAD_POOL_H
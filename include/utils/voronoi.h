@@ -0,0 +1,61 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef UTILS_VORONOI_H
+#define UTILS_VORONOI_H
+
+#include <glm/glm.hpp>
+#include <utils/math_util.h>
+#include <vector>
+
+
+namespace utils::math {
+
+// Voronoi diagram as a flat half-edge structure plus its dual Delaunay triangulation.
+// Vertex index -1 marks the open end of an unbounded edge; next/prev are -1 across it.
+struct VoronoiDiagram {
+	struct HalfEdge {
+		int origin{-1};
+		int destination{-1};
+		int twin{-1};
+		int next{-1};
+		int prev{-1};
+		// input index of the site whose cell this half-edge bounds
+		int site{-1};
+	};
+
+	std::vector<glm::dvec2> vertices;
+	std::vector<HalfEdge> half_edges;
+	// one half-edge of each input site's cell, -1 for duplicate sites
+	std::vector<int> cells;
+	// Delaunay triangles as consecutive triples of input site indices
+	std::vector<int> triangles;
+};
+
+// Fortune's sweep line in O(n log n), sweeping towards +y
+VoronoiDiagram compute_voronoi(const std::vector<Point_2> &points);
+
+} // namespace utils::math
+
+#endif //UTILS_VORONOI_H
@@ -0,0 +1,78 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utils/binomial.h>
+#include <vector>
+
+
+namespace utils::math {
+
+namespace {
+
+std::array<std::atomic<const double *>, max_binomial_degree_f64 + 1> extended_rows{};
+std::vector<std::unique_ptr<double[]>> extended_storage;
+std::mutex extended_mutex;
+
+const double *extended_row(int n) {
+    if (auto row = extended_rows[n].load(std::memory_order_acquire))
+        return row;
+
+    std::lock_guard lock(extended_mutex);
+    // continue from the highest row built so far, or from the exact table
+    int built = n;
+    while (built > max_binomial_degree_u64 && !extended_rows[built].load(std::memory_order_relaxed))
+        built--;
+    for (int m = built + 1; m <= n; m++) {
+        auto row = std::make_unique<double[]>(m + 1);
+        row[0] = row[m] = 1.0;
+        if (m - 1 > max_binomial_degree_u64) {
+            const double *above = extended_rows[m - 1].load(std::memory_order_relaxed);
+            for (int k = 1; k < m; k++)
+                row[k] = above[k - 1] + above[k];
+        } else {
+            for (int k = 1; k < m; k++)
+                row[k] = static_cast<double>(binomial_coeff_u64(m - 1, k - 1))
+                         + static_cast<double>(binomial_coeff_u64(m - 1, k));
+        }
+        extended_rows[m].store(row.get(), std::memory_order_release);
+        extended_storage.push_back(std::move(row));
+    }
+    return extended_rows[n].load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+double binomial_coeff_f64(int n, int k) {
+    assert(n >= 0 && n <= max_binomial_degree_f64);
+    if (k < 0 || k > n)
+        return 0.0;
+    if (n <= max_binomial_degree_u64)
+        return static_cast<double>(binomial_coeff_u64(n, k));
+    return extended_row(n)[k];
+}
+
+} // namespace utils::math
@@ -0,0 +1,338 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <utils/bulk_loader.h>
+#include <utils/json_cache.h>
+
+#if defined(UTILS_IO_URING) && __has_include(<liburing.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#define UTILS_HAS_IO_URING 1
+#else
+#define UTILS_HAS_IO_URING 0
+#endif
+
+
+namespace utils::file {
+
+namespace {
+
+// shared by the tasks of one load_files call, which may outlive it
+struct Load {
+    std::vector<std::string> paths;
+    // from a stat pass up front, 0 when unknown; what each file reserves against the cap
+    std::vector<std::uint64_t> sizes;
+    decode_kind kind;
+    std::uint64_t memory_cap;
+    std::size_t queue_depth;
+    parallel::ThreadPool *pool;
+    loaded_file_callback deliver;
+    // files are read by the io_uring thread instead of pool tasks
+    bool ring{false};
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    // first path not started
+    std::size_t next{0};
+    // started and not yet delivered
+    std::size_t active{0};
+    std::size_t delivered{0};
+    std::uint64_t reserved{0};
+    std::exception_ptr callback_error;
+
+    // under mutex; a lone file always fits so one larger than the cap cannot stall the load
+    bool may_start() const {
+        if (next == paths.size())
+            return false;
+        if (active == 0)
+            return true;
+        return active < queue_depth && reserved + sizes[next] <= memory_cap;
+    }
+
+    // under mutex
+    std::size_t start() {
+        reserved += sizes[next];
+        active++;
+        return next++;
+    }
+};
+
+// the synchronous readers, used by pool tasks
+void read_and_decode(loaded_file &file, decode_kind kind) {
+    try {
+        switch (kind) {
+            case decode_kind::raw:
+                file.content = read_file_to_string(file.path);
+                break;
+            case decode_kind::json:
+                file.content = read_json_file(file.path);
+                break;
+            case decode_kind::png:
+                file.content = read_png_file(file.path);
+                break;
+        }
+    } catch (...) {
+        file.error = std::current_exception();
+    }
+}
+
+void pump(const std::shared_ptr<Load> &load);
+
+void finish(const std::shared_ptr<Load> &load, loaded_file &file) {
+    std::exception_ptr error;
+    try {
+        load->deliver(file);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    {
+        std::lock_guard lock(load->mutex);
+        if (error && !load->callback_error)
+            load->callback_error = error;
+        load->reserved -= load->sizes[file.index];
+        load->active--;
+        load->delivered++;
+    }
+    load->changed.notify_all();
+    if (!load->ring)
+        pump(load);
+}
+
+// starts every path that fits as a pool task, called again as each file is delivered
+void pump(const std::shared_ptr<Load> &load) {
+    std::vector<std::size_t> starting;
+    {
+        std::lock_guard lock(load->mutex);
+        while (load->may_start())
+            starting.push_back(load->start());
+    }
+    for (auto index: starting) {
+        load->pool->submit([load, index] {
+            loaded_file file{index, load->paths[index], {}, {}};
+            read_and_decode(file, load->kind);
+            finish(load, file);
+        });
+    }
+}
+
+#if UTILS_HAS_IO_URING
+// one file moving through the ring
+struct RingRead {
+    std::size_t index;
+    int fd;
+    std::string buffer;
+    std::size_t done{0};
+};
+
+void queue_read(io_uring &ring, RingRead *read) {
+    auto *sqe = io_uring_get_sqe(&ring);
+    if (!sqe) {
+        io_uring_submit(&ring);
+        sqe = io_uring_get_sqe(&ring);
+    }
+    // reads are capped so huge files go through in several steps
+    auto length = static_cast<unsigned>(std::min<std::size_t>(read->buffer.size() - read->done, 1u << 30));
+    io_uring_prep_read(sqe, read->fd, read->buffer.data() + read->done, length, read->done);
+    io_uring_sqe_set_data(sqe, read);
+}
+
+// decoding of a finished read runs on the pool
+void decode_read(const std::shared_ptr<Load> &load, std::unique_ptr<RingRead> read) {
+    std::shared_ptr<RingRead> owned(std::move(read));
+    load->pool->submit([load, owned] {
+        loaded_file file{owned->index, load->paths[owned->index], {}, {}};
+        try {
+            switch (load->kind) {
+                case decode_kind::raw:
+                    file.content = std::move(owned->buffer);
+                    break;
+                case decode_kind::json:
+                    file.content = json::parse(owned->buffer);
+                    break;
+                case decode_kind::png:
+                    file.content = decode_png(std::as_bytes(std::span(owned->buffer)), file.path);
+                    break;
+            }
+        } catch (...) {
+            file.error = std::current_exception();
+        }
+        owned->buffer = std::string();
+        finish(load, file);
+    });
+}
+
+// files the ring cannot size up front (pipes, procfs) and failed opens go down the blocking path
+void read_on_pool(const std::shared_ptr<Load> &load, std::size_t index) {
+    load->pool->submit([load, index] {
+        loaded_file file{index, load->paths[index], {}, {}};
+        read_and_decode(file, load->kind);
+        finish(load, file);
+    });
+}
+
+void drive_ring(const std::shared_ptr<Load> &load, std::unique_ptr<io_uring> ring) {
+    std::size_t in_ring = 0;
+    while (true) {
+        std::vector<std::size_t> starting;
+        {
+            std::unique_lock lock(load->mutex);
+            if (in_ring == 0)
+                load->changed.wait(lock, [&] { return load->next == load->paths.size() || load->may_start(); });
+            while (load->may_start())
+                starting.push_back(load->start());
+            if (starting.empty() && in_ring == 0)
+                break;
+        }
+        for (auto index: starting) {
+            int fd = ::open(load->paths[index].c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat info{};
+            if (fd < 0 || ::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+                if (fd >= 0)
+                    ::close(fd);
+                read_on_pool(load, index);
+                continue;
+            }
+            auto *read = new RingRead{index, fd, std::string(static_cast<std::size_t>(info.st_size), '\0')};
+            queue_read(*ring, read);
+            in_ring++;
+        }
+        if (in_ring == 0)
+            continue;
+
+        io_uring_submit_and_wait(ring.get(), 1);
+        io_uring_cqe *cqe;
+        while (io_uring_peek_cqe(ring.get(), &cqe) == 0) {
+            std::unique_ptr<RingRead> read(static_cast<RingRead *>(io_uring_cqe_get_data(cqe)));
+            const int result = cqe->res;
+            io_uring_cqe_seen(ring.get(), cqe);
+            if (result == -EINTR || result == -EAGAIN) {
+                queue_read(*ring, read.release());
+                continue;
+            }
+            if (result < 0) {
+                ::close(read->fd);
+                in_ring--;
+                read_on_pool(load, read->index);
+                continue;
+            }
+            read->done += static_cast<std::size_t>(result);
+            // a file that shrank since it was sized ends early
+            if (result > 0 && read->done < read->buffer.size()) {
+                queue_read(*ring, read.release());
+                continue;
+            }
+            ::close(read->fd);
+            in_ring--;
+            read->buffer.resize(read->done);
+            decode_read(load, std::move(read));
+        }
+    }
+    io_uring_queue_exit(ring.get());
+}
+
+// false when the kernel refuses a ring, leaving the load to the pool
+bool start_ring(const std::shared_ptr<Load> &load) {
+    // the sidecar cache lives in read_json_file
+    if (load->kind == decode_kind::json && json_cache_enabled())
+        return false;
+    auto ring = std::make_unique<io_uring>();
+    const auto entries = static_cast<unsigned>(std::clamp<std::size_t>(load->queue_depth, 1, 4096));
+    if (io_uring_queue_init(entries, ring.get(), 0) < 0)
+        return false;
+    load->queue_depth = entries;
+    load->ring = true;
+    std::thread(drive_ring, load, std::move(ring)).detach();
+    return true;
+}
+#endif
+
+std::shared_ptr<Load> begin_load(std::vector<std::string> paths, const bulk_load_options &options,
+                                 loaded_file_callback deliver) {
+    auto load = std::make_shared<Load>();
+    load->paths = std::move(paths);
+    load->kind = options.kind;
+    load->memory_cap = options.memory_cap;
+    load->queue_depth = std::max<std::size_t>(options.queue_depth, 1);
+    load->pool = options.pool ? options.pool : &parallel::ThreadPool::global();
+    load->deliver = std::move(deliver);
+
+    load->sizes.resize(load->paths.size());
+    load->pool->parallel_for(load->paths.size(), 256, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++) {
+            std::error_code ec;
+            auto size = std::filesystem::file_size(load->paths[i], ec);
+            load->sizes[i] = ec ? 0 : size;
+        }
+    });
+
+#if UTILS_HAS_IO_URING
+    if (start_ring(load))
+        return load;
+#endif
+    pump(load);
+    return load;
+}
+
+} // namespace
+
+void load_files(std::span<const std::string> paths,
+                const bulk_load_options &options,
+                const loaded_file_callback &callback) {
+    if (paths.empty())
+        return;
+    // the callback outlives nothing: this call returns only after the last file is delivered
+    auto load = begin_load({paths.begin(), paths.end()}, options, [&callback](loaded_file &file) {
+        callback(file);
+    });
+    std::unique_lock lock(load->mutex);
+    load->changed.wait(lock, [&] { return load->delivered == load->paths.size(); });
+    if (load->callback_error)
+        std::rethrow_exception(load->callback_error);
+}
+
+std::vector<std::future<loaded_file>> load_files_async(std::vector<std::string> paths,
+                                                       const bulk_load_options &options) {
+    auto promises = std::make_shared<std::vector<std::promise<loaded_file>>>(paths.size());
+    std::vector<std::future<loaded_file>> futures;
+    futures.reserve(paths.size());
+    for (auto &promise: *promises)
+        futures.push_back(promise.get_future());
+    if (!paths.empty()) {
+        begin_load(std::move(paths), options, [promises](loaded_file &file) {
+            (*promises)[file.index].set_value(std::move(file));
+        });
+    }
+    return futures;
+}
+
+} // namespace utils::file
@@ -22,165 +22,183 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <bit>
+#include <cstring>
 #include <fmt/format.h>
 #include <fstream>
 #include <iostream>
 #include <png.h>
-#include <pngstruct.h>
-#include <pnginfo.h>
 #include <stdexcept>
 #include <utils/file_util.h>
+#include <utils/json_cache.h>
+#include <utils/mapped_file.h>
 
 
 using std::runtime_error;
-using namespace nlohmann::json_schema;
 
 namespace utils::file {
 
+namespace {
+
+// parses straight out of the mapped file, or decodes its binary sidecar when the cache is on and fresh
+json parse_json_file(const std::string &path) {
+    MappedFile file;
+    try {
+        file = MappedFile(path, access_pattern::sequential);
+    } catch (const runtime_error &) {
+        std::string message = fmt::format("Error reading json file at {0}", path);
+        throw runtime_error(message.c_str());
+    }
+    if (!json_cache_enabled())
+        return json::parse(file.view());
+    if (auto cached = load_json_cache(path, file.bytes()))
+        return std::move(*cached);
+    auto data = json::parse(file.view());
+    store_json_cache(path, file.bytes(), data);
+    return data;
+}
+
+} // namespace
+
 json read_json_file(const std::string &path, const json &schema) {
-    std::ifstream file(path);
-    if (file.good()) {
-        auto data = json::parse(file);
-        if (schema != nullptr) {
-            json_validator validator;
-            try {
-                validator.set_root_schema(schema);
-            } catch (runtime_error e) {
-                std::cerr << "Schema error: " << e.what() << std::endl;
-            }
-            try {
-                validator.validate(data);
-            } catch (runtime_error e) {
-                std::cerr << "Validation error: " << e.what() << std::endl;
-            }
+    auto data = parse_json_file(path);
+    if (schema != nullptr) {
+        try {
+            for (const auto &error: SchemaRegistry::global().validate(data, schema).errors)
+                std::cerr << "Validation error at '" << error.pointer << "': " << error.message << std::endl;
+        } catch (const runtime_error &e) {
+            std::cerr << e.what() << std::endl;
         }
-        return data;
     }
-    std::string message = fmt::format("Error reading json file at {0}", path);
-    throw runtime_error(message.c_str());
+    return data;
 }
 
-GLuint read_png_file_to_texture(const std::string &path) {
-    // Reference: http://www.libpng.org/pub/png/libpng-1.4.0-manual.pdf
-    FILE* fp = fopen(path.c_str(), "rb");
-    if(!fp) {
-        std::string message = fmt::format("Error reading png file at {0}", path);
+json read_json_file(const std::string &path, const json &schema, validation_result &result) {
+    auto data = parse_json_file(path);
+    result = schema != nullptr ? SchemaRegistry::global().validate(data, schema) : validation_result{};
+    return data;
+}
+
+image decode_png(std::span<const std::byte> bytes, const std::string &name) {
+    // Reference: http://www.libpng.org/pub/png/libpng-1.6.0-manual.pdf
+    if (bytes.size() < 8 || png_sig_cmp(reinterpret_cast<png_const_bytep>(bytes.data()), 0, 8)) {
+        std::string message = fmt::format("File header at {0} does not match png", name);
+        throw runtime_error(message.c_str());
+    }
+    png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (!png_ptr) {
+        std::string message = fmt::format("Failed to create png read struct {0}", name);
+        throw runtime_error(message.c_str());
+    }
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+    if (!info_ptr) {
+        png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+        std::string message = fmt::format("Failed to create png info struct {0}", name);
         throw runtime_error(message.c_str());
     }
-    char header[8];
-    fread(header, 1, 8, fp);
-    if(!png_sig_cmp(reinterpret_cast<png_const_bytep>(header), 0, 8)) {
-        png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-        if(!png_ptr) {
-            std::string message = fmt::format("Failed to create png read struct {0}", path);
-            throw runtime_error(message.c_str());
-        }
-        png_infop info_ptr = png_create_info_struct(png_ptr);
-        if(!info_ptr){
-            png_destroy_read_struct(&png_ptr,(png_infopp)NULL, (png_infopp)NULL);
-            std::string message = fmt::format("Failed to create png info struct {0}", path);
-            throw runtime_error(message.c_str());
-        }
-        png_infop end_info = png_create_info_struct(png_ptr);
-        if(!end_info){
-            png_destroy_read_struct(&png_ptr, &info_ptr,(png_infopp)NULL);
-            std::string message = fmt::format("Failed to create png end info struct {0}", path);
-            throw runtime_error(message.c_str());
-        }
-        if(setjmp(png_jmpbuf(png_ptr))){
-            png_destroy_read_struct(&png_ptr, &info_ptr,&end_info);
-            fclose(fp);
-            std::string message = fmt::format("Lib png error {0}", path);
-            throw runtime_error(message.c_str());
-        }
-        png_set_sig_bytes(png_ptr, 8);
-        png_init_io(png_ptr, fp);
-        auto png_transforms = PNG_TRANSFORM_IDENTITY;
-        png_read_png(png_ptr, info_ptr, png_transforms, NULL);
-        GLuint tex_id;
-        glGenTextures(1, &tex_id);
-        glBindTexture(GL_TEXTURE_2D, tex_id);
-        auto size = GL_UNSIGNED_BYTE;
-        if(info_ptr->bit_depth == 16)
-            size = GL_UNSIGNED_SHORT;
-        if(info_ptr->bit_depth == 32)
-            size = GL_UNSIGNED_INT;
-        auto format = GL_RGB;
-        switch(info_ptr->color_type) {
-            case PNG_COLOR_TYPE_RGB:
-                format = GL_RGB;
-                break;
-            case PNG_COLOR_TYPE_RGBA:
-                format = GL_RGBA;
-                break;
-            case PNG_COLOR_TYPE_PALETTE:
-                format = GL_RGB;
-                size = GL_UNSIGNED_BYTE;
-                break;
-            case PNG_COLOR_TYPE_GRAY:
-                png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-                throw runtime_error("Gray PNG format not supported");
-            case PNG_COLOR_TYPE_GRAY_ALPHA:
-                png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-                throw runtime_error("Gray Alpha PNG format not supported");
-            default:
-                png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-                throw runtime_error(fmt::format("Format #{} not supported", info_ptr->color_type));
-        }
-        auto w = info_ptr->width;
-        auto h = info_ptr->height;
-        auto stride = info_ptr->pixel_depth/8;
-        unsigned char *data;
-        if(info_ptr->color_type == PNG_COLOR_TYPE_PALETTE)
-            data = new unsigned char[3*h*info_ptr->rowbytes];
-        else
-            data = new unsigned char[h*info_ptr->rowbytes];
-        for(int y = 0; y < h; y++) {
-            for(int x = 0; x < info_ptr->rowbytes; x += stride) {
-                if(info_ptr->color_type == PNG_COLOR_TYPE_PALETTE) {
-                    unsigned char index = info_ptr->row_pointers[y][x];
-                    auto pixel = info_ptr->palette[index];
-                    data[3 * (y * info_ptr->rowbytes + x)] = pixel.red;
-                    data[3 * (y * info_ptr->rowbytes + x) + 1] = pixel.green;
-                    data[3 * (y * info_ptr->rowbytes + x) + 2] = pixel.blue;
-                } else {
-                    for (int i = 0; i < stride; i++)
-                        data[y * info_ptr->rowbytes + x + i] = info_ptr->row_pointers[y][x + i];
-                }
-            }
-        }
 
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, format, size, data);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    // declared before setjmp so a libpng error jumps back past nothing that needs destroying
+    image result;
+    std::vector<png_bytep> rows;
+    auto remaining = bytes.subspan(8);
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+        std::string message = fmt::format("Lib png error {0}", name);
+        throw runtime_error(message.c_str());
+    }
+    png_set_read_fn(png_ptr, &remaining, [](png_structp png, png_bytep out, png_size_t count) {
+        auto &source = *static_cast<std::span<const std::byte> *>(png_get_io_ptr(png));
+        if (count > source.size())
+            png_error(png, "unexpected end of data");
+        std::memcpy(out, source.data(), count);
+        source = source.subspan(count);
+    });
+    png_set_sig_bytes(png_ptr, 8);
+    png_read_info(png_ptr, info_ptr);
+
+    // palettes, transparency chunks and packed gray all come out as whole 8 bit samples
+    png_set_palette_to_rgb(png_ptr);
+    png_set_expand_gray_1_2_4_to_8(png_ptr);
+    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+        png_set_tRNS_to_alpha(png_ptr);
+    if constexpr (std::endian::native == std::endian::little)
+        png_set_swap(png_ptr);
+    png_set_interlace_handling(png_ptr);
+    png_read_update_info(png_ptr, info_ptr);
+
+    result.width = png_get_image_width(png_ptr, info_ptr);
+    result.height = png_get_image_height(png_ptr, info_ptr);
+    result.channels = png_get_channels(png_ptr, info_ptr);
+    result.bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+    const auto stride = png_get_rowbytes(png_ptr, info_ptr);
+    result.pixels.resize(stride * result.height);
+    rows.resize(result.height);
+    for (std::size_t y = 0; y < rows.size(); y++)
+        rows[y] = result.pixels.data() + y * stride;
+    png_read_image(png_ptr, rows.data());
+    png_read_end(png_ptr, nullptr);
+
+    // cleanup
+    png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+    return result;
+}
 
-        // cleanup
-        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-        delete[] data;
+image read_png_file(const std::string &path) {
+    MappedFile file;
+    try {
+        file = MappedFile(path, access_pattern::sequential);
+    } catch (const runtime_error &) {
+        std::string message = fmt::format("Error reading png file at {0}", path);
+        throw runtime_error(message.c_str());
+    }
+    return decode_png(file.bytes(), path);
+}
 
-        return tex_id;
+GLuint image_to_texture(const image &picture) {
+    auto format = GL_RGB;
+    switch (picture.channels) {
+        case 3:
+            format = GL_RGB;
+            break;
+        case 4:
+            format = GL_RGBA;
+            break;
+        case 1:
+            throw runtime_error("Gray PNG format not supported");
+        case 2:
+            throw runtime_error("Gray Alpha PNG format not supported");
+        default:
+            throw runtime_error(fmt::format("Format with {} channels not supported", picture.channels));
     }
-    std::string message = fmt::format("File header at {0} does not match png", path);
-    throw runtime_error(message.c_str());
+    auto size = picture.bit_depth == 16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+
+    GLuint tex_id;
+    glGenTextures(1, &tex_id);
+    glBindTexture(GL_TEXTURE_2D, tex_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(picture.width),
+                 static_cast<GLsizei>(picture.height), 0, format, size, picture.pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    return tex_id;
+}
+
+GLuint read_png_file_to_texture(const std::string &path) {
+    return image_to_texture(read_png_file(path));
 }
 
 std::string read_file_to_string(const std::string &path) {
-    std::ifstream file(path);
-    if (file.good()) {
-        std::string data{(std::istreambuf_iterator<char>(file)),
-                         (std::istreambuf_iterator<char>())};
-        return data;
-    }
-    std::string message = fmt::format("Error reading file at {0}", path);
-    throw runtime_error(message.c_str());
+    return std::string(MappedFile(path, access_pattern::sequential).view());
 }
 
 void write_json_file(const std::string &path, const json &data) {
+    auto text = data.dump();
     std::ofstream file;
     file.open(path);
-    file << data;
+    file << text;
     file.close();
+    if (json_cache_enabled())
+        store_json_cache(path, std::as_bytes(std::span(text)), data);
 }
 
 } // namespace utils::file
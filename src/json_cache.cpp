@@ -0,0 +1,331 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <limits>
+#include <utils/json_cache.h>
+#include <utils/mapped_file.h>
+#include <utils/random.h>
+#include <vector>
+
+
+namespace utils::file {
+
+namespace {
+
+constexpr char magic[4] = {'U', 'J', 'C', 'B'};
+constexpr std::uint32_t version = 1;
+
+struct sidecar_header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+    std::uint64_t source_hash;
+};
+
+std::atomic<bool> cache_enabled{false};
+
+// four independent multiply-rotate lanes over 8-byte words, so hashing runs well ahead of parsing
+std::uint64_t content_hash(std::span<const std::byte> bytes) {
+    constexpr std::uint64_t k1 = 0x9e3779b97f4a7c15ULL, k2 = 0xc2b2ae3d27d4eb4fULL;
+    std::uint64_t lanes[4] = {k1, k2, k1 ^ k2, bytes.size()};
+    std::size_t i = 0;
+    for (; i + 32 <= bytes.size(); i += 32) {
+        for (int l = 0; l < 4; l++) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes.data() + i + 8 * l, 8);
+            lanes[l] = std::rotl(lanes[l] ^ word * k1, 31) * k2;
+        }
+    }
+    std::uint64_t tail[4] = {};
+    std::memcpy(tail, bytes.data() + i, bytes.size() - i);
+    std::uint64_t state = bytes.size();
+    for (int l = 0; l < 4; l++) {
+        state ^= random::splitmix64(lanes[l]);
+        state ^= random::splitmix64(tail[l]);
+    }
+    return random::splitmix64(state);
+}
+
+// builds the document straight from the CBOR json::to_cbor writes, with objects appended in their stored
+// (already sorted) key order; json::from_cbor goes through its sax interface a byte at a time and ends up
+// slower than parsing the text. Tags and indefinite lengths never come out of to_cbor and throw unsupported.
+class CborDecoder {
+public:
+    struct unsupported {};
+
+    explicit CborDecoder(std::span<const std::byte> bytes)
+        : data_(reinterpret_cast<const std::uint8_t *>(bytes.data())), size_(bytes.size()) {}
+
+    json decode() {
+        auto value = next();
+        if (pos_ != size_)
+            throw unsupported{};
+        return value;
+    }
+
+private:
+    const std::uint8_t *data_;
+    std::size_t size_;
+    std::size_t pos_{0};
+
+    const std::uint8_t *take(std::size_t count) {
+        if (count > size_ - pos_)
+            throw unsupported{};
+        auto *first = data_ + pos_;
+        pos_ += count;
+        return first;
+    }
+
+    std::uint64_t big_endian(std::size_t width) {
+        auto *bytes = take(width);
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < width; i++)
+            value = value << 8 | bytes[i];
+        return value;
+    }
+
+    std::uint64_t argument(std::uint8_t info) {
+        if (info < 24)
+            return info;
+        if (info > 27)
+            throw unsupported{};
+        return big_endian(std::size_t{1} << (info - 24));
+    }
+
+    // element counts are bounded by the bytes left, so corrupt lengths cannot reserve wildly
+    std::size_t count(std::uint8_t info) {
+        auto n = argument(info);
+        if (n > size_ - pos_)
+            throw unsupported{};
+        return static_cast<std::size_t>(n);
+    }
+
+    std::string string(std::uint8_t info) {
+        auto length = count(info);
+        return {reinterpret_cast<const char *>(take(length)), length};
+    }
+
+    std::string key() {
+        const auto initial = *take(1);
+        if (initial >> 5 != 3)
+            throw unsupported{};
+        return string(initial & 31);
+    }
+
+    static double half(std::uint16_t bits) {
+        const int exponent = bits >> 10 & 31;
+        const double mantissa = bits & 1023;
+        double value;
+        if (exponent == 0)
+            value = std::ldexp(mantissa, -24);
+        else if (exponent == 31)
+            value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        else
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        return bits & 0x8000 ? -value : value;
+    }
+
+    json next() {
+        const auto initial = *take(1);
+        const std::uint8_t info = initial & 31;
+        switch (initial >> 5) {
+            case 0:
+                return argument(info);
+            case 1: {
+                auto magnitude = argument(info);
+                if (magnitude > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                    throw unsupported{};
+                return -1 - static_cast<std::int64_t>(magnitude);
+            }
+            case 2: {
+                auto length = count(info);
+                auto *first = take(length);
+                return json::binary(std::vector<std::uint8_t>(first, first + length));
+            }
+            case 3:
+                return string(info);
+            case 4: {
+                auto length = count(info);
+                json value = json::array();
+                auto &array = value.get_ref<json::array_t &>();
+                array.reserve(length);
+                for (std::size_t i = 0; i < length; i++)
+                    array.push_back(next());
+                return value;
+            }
+            case 5: {
+                auto length = count(info);
+                json value = json::object();
+                auto &object = value.get_ref<json::object_t &>();
+                for (std::size_t i = 0; i < length; i++) {
+                    auto name = key();
+                    object.emplace_hint(object.end(), std::move(name), next());
+                }
+                return value;
+            }
+            case 7:
+                switch (info) {
+                    case 20:
+                        return false;
+                    case 21:
+                        return true;
+                    case 22:
+                        return nullptr;
+                    case 25:
+                        return half(static_cast<std::uint16_t>(big_endian(2)));
+                    case 26:
+                        return static_cast<double>(std::bit_cast<float>(static_cast<std::uint32_t>(big_endian(4))));
+                    case 27:
+                        return std::bit_cast<double>(big_endian(8));
+                    default:
+                        throw unsupported{};
+                }
+            default:
+                throw unsupported{};
+        }
+    }
+};
+
+// false when dump() would not give the document back: it writes non-finite numbers as null and binary
+// values as objects
+bool survives_text(const json &data) {
+    switch (data.type()) {
+        case json::value_t::number_float:
+            return std::isfinite(data.get<double>());
+        case json::value_t::binary:
+            return false;
+        case json::value_t::array:
+        case json::value_t::object:
+            return std::all_of(data.begin(), data.end(), [](const json &value) { return survives_text(value); });
+        default:
+            return true;
+    }
+}
+
+// source size and modification time, nullopt if the file cannot be queried
+std::optional<std::pair<std::uint64_t, std::int64_t>> source_stamp(const std::string &path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return std::nullopt;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return std::nullopt;
+    return std::pair{static_cast<std::uint64_t>(size), static_cast<std::int64_t>(mtime.time_since_epoch().count())};
+}
+
+} // namespace
+
+void set_json_cache_enabled(bool enabled) {
+    cache_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool json_cache_enabled() {
+    return cache_enabled.load(std::memory_order_relaxed);
+}
+
+std::string json_cache_path(const std::string &path) {
+    return path + ".cbor";
+}
+
+std::optional<json> load_json_cache(const std::string &path, std::span<const std::byte> text) {
+    auto stamp = source_stamp(path);
+    if (!stamp)
+        return std::nullopt;
+    try {
+        MappedFile sidecar(json_cache_path(path), access_pattern::sequential);
+        sidecar_header header{};
+        if (sidecar.size() < sizeof(header))
+            return std::nullopt;
+        std::memcpy(&header, sidecar.bytes().data(), sizeof(header));
+        // the cheap checks first, the hash of the text last
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version
+            || header.source_size != stamp->first || header.source_size != text.size()
+            || header.source_mtime != stamp->second || header.source_hash != content_hash(text))
+            return std::nullopt;
+        auto body = sidecar.bytes().subspan(sizeof(header));
+        try {
+            return CborDecoder(body).decode();
+        } catch (const CborDecoder::unsupported &) {
+            auto *first = reinterpret_cast<const std::uint8_t *>(body.data());
+            return json::from_cbor(first, first + body.size());
+        }
+    } catch (const std::exception &) {
+        // missing or corrupt sidecars just miss
+        return std::nullopt;
+    }
+}
+
+bool store_json_cache(const std::string &path, std::span<const std::byte> text, const json &data) {
+    auto stamp = source_stamp(path);
+    if (!stamp)
+        return false;
+    sidecar_header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.source_size = stamp->first;
+    header.source_mtime = stamp->second;
+    header.source_hash = content_hash(text);
+    // the sidecar must hold what the text parses to, which differs where dump() is lossy
+    std::vector<std::uint8_t> body;
+    if (survives_text(data)) {
+        body = json::to_cbor(data);
+    } else {
+        auto *first = reinterpret_cast<const char *>(text.data());
+        body = json::to_cbor(json::parse(first, first + text.size()));
+    }
+
+    // readers never see a half written sidecar, and concurrent writers each get their own temporary
+    const auto target = json_cache_path(path);
+    const auto temporary = fmt::format("{0}.{1:016x}.tmp", target, random::thread_generator()());
+    std::error_code ec;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(body.data()), static_cast<std::streamsize>(body.size()));
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, target, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace utils::file
@@ -0,0 +1,320 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdint>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <utility>
+#include <utils/json_stream.h>
+#include <utils/mapped_file.h>
+
+
+using std::runtime_error;
+
+namespace utils::file {
+
+namespace {
+
+// the unescaped reference tokens of a json pointer
+std::vector<std::string> pointer_tokens(const std::string &pointer) {
+    try {
+        json::json_pointer checked(pointer);
+    } catch (const json::exception &e) {
+        throw runtime_error(fmt::format("Invalid json pointer {0}: {1}", pointer, e.what()));
+    }
+    std::vector<std::string> tokens;
+    for (std::size_t i = 0; i < pointer.size(); i++) {
+        if (pointer[i] == '/')
+            tokens.emplace_back();
+        else if (pointer[i] == '~')
+            tokens.back() += pointer[++i] == '0' ? '~' : '/';
+        else
+            tokens.back() += pointer[i];
+    }
+    return tokens;
+}
+
+// SAX handler that builds one record at a time and skips everything outside the records and fields
+class RecordReader : public json::json_sax_t {
+public:
+    RecordReader(const json_stream_options &options, const json_record_callback &callback)
+            : callback_(callback), validator_(options.validator.get()), records_(pointer_tokens(options.records)) {
+        for (const auto &field: options.fields) {
+            fields_.push_back(pointer_tokens(field));
+            field_pointers_.emplace_back(field);
+        }
+    }
+
+    [[nodiscard]]
+    std::size_t delivered() const {
+        return delivered_;
+    }
+
+    bool null() override {
+        return scalar(nullptr);
+    }
+
+    bool boolean(bool val) override {
+        return scalar(val);
+    }
+
+    bool number_integer(json::number_integer_t val) override {
+        return scalar(val);
+    }
+
+    bool number_unsigned(json::number_unsigned_t val) override {
+        return scalar(val);
+    }
+
+    bool number_float(json::number_float_t val, const json::string_t &) override {
+        return scalar(val);
+    }
+
+    bool string(json::string_t &val) override {
+        return scalar(std::move(val));
+    }
+
+    bool binary(json::binary_t &val) override {
+        return scalar(std::move(val));
+    }
+
+    bool start_object(std::size_t) override {
+        return open(json::value_t::object);
+    }
+
+    bool start_array(std::size_t) override {
+        return open(json::value_t::array);
+    }
+
+    bool end_object() override {
+        return close();
+    }
+
+    bool end_array() override {
+        return close();
+    }
+
+    bool key(json::string_t &val) override {
+        if (skip_ == 0)
+            frames_.back().key = val;
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string &, const json::exception &ex) override {
+        throw runtime_error(fmt::format("Json parse error at byte {0}: {1}", position, ex.what()));
+    }
+
+private:
+    enum class Role : std::uint8_t {
+        // containers on the way down to the records container
+        path,
+        records,
+        // parts of a record that are built whole, built only where fields lead, or not built at all
+        keep,
+        pick,
+        skip
+    };
+
+    struct Frame {
+        Role role;
+        bool array;
+        std::size_t index;
+        // pending member name of an object
+        std::string key;
+        // name of this container in its parent
+        std::string token;
+        json *node;
+        // length of a picked array up to its last built element, the placeholders after it are dropped
+        std::size_t built;
+    };
+
+    // role of the value about to start; sets token_ to its name in the parent
+    Role classify() {
+        if (frames_.empty()) {
+            token_.clear();
+            return records_.empty() ? Role::records : Role::path;
+        }
+        auto &parent = frames_.back();
+        token_ = parent.array ? std::to_string(parent.index) : parent.key;
+        const auto index = parent.index++;
+        switch (parent.role) {
+            case Role::path: {
+                const auto depth = frames_.size();
+                if (records_[depth - 1] != token_)
+                    return Role::skip;
+                return depth == records_.size() ? Role::records : Role::path;
+            }
+            case Role::records:
+                record_index_ = index;
+                record_key_ = parent.array ? std::string() : parent.key;
+                record_frame_ = frames_.size();
+                return fields_.empty() || validator_ ? Role::keep : pick_role(0);
+            case Role::keep:
+                return Role::keep;
+            default:
+                return pick_role(frames_.size() - record_frame_);
+        }
+    }
+
+    // keep when a field leads to or into the value at relative depth, pick when one leads through it
+    [[nodiscard]]
+    Role pick_role(std::size_t depth) const {
+        auto role = Role::skip;
+        for (const auto &field: fields_) {
+            bool match = true;
+            for (std::size_t i = 0; match && i < std::min(depth, field.size()); i++) {
+                const auto &token = i + 1 < depth ? frames_[record_frame_ + 1 + i].token : token_;
+                match = token == field[i];
+            }
+            if (!match)
+                continue;
+            if (field.size() <= depth)
+                return Role::keep;
+            role = Role::pick;
+        }
+        return role;
+    }
+
+    // the record root or a member of its open parent, returns where it was stored
+    json *attach(json value) {
+        if (frames_.empty() || frames_.back().role == Role::records) {
+            record_ = std::move(value);
+            return &record_;
+        }
+        auto &parent = frames_.back();
+        if (parent.array) {
+            parent.node->push_back(std::move(value));
+            parent.built = parent.node->size();
+            return &parent.node->back();
+        }
+        return &((*parent.node)[parent.key] = std::move(value));
+    }
+
+    [[nodiscard]]
+    bool is_record_root() const {
+        return !frames_.empty() && frames_.back().role == Role::records;
+    }
+
+    // picked arrays keep the positions of the elements they leave out
+    void hold_place() {
+        if (!frames_.empty() && frames_.back().role == Role::pick && frames_.back().array)
+            frames_.back().node->push_back(nullptr);
+    }
+
+    template <typename T>
+    bool scalar(T &&val) {
+        if (skip_ > 0)
+            return true;
+        const auto role = classify();
+        if (role == Role::keep)
+            attach(json(std::forward<T>(val)));
+        else if (role == Role::pick || role == Role::skip)
+            hold_place();
+        return is_record_root() ? finish() : true;
+    }
+
+    bool open(json::value_t type) {
+        if (skip_ > 0) {
+            skip_++;
+            return true;
+        }
+        const auto role = classify();
+        if (role == Role::skip) {
+            hold_place();
+            skip_ = 1;
+            return true;
+        }
+        json *node = role == Role::keep || role == Role::pick ? attach(json(type)) : nullptr;
+        frames_.push_back({role, type == json::value_t::array, 0, {}, std::move(token_), node, 0});
+        return true;
+    }
+
+    bool close() {
+        if (skip_ > 0) {
+            skip_--;
+            return true;
+        }
+        const auto &frame = frames_.back();
+        const auto role = frame.role;
+        if (role == Role::pick && frame.array)
+            frame.node->get_ref<json::array_t &>().resize(frame.built);
+        frames_.pop_back();
+        // nothing after the records container matters
+        if (role == Role::records)
+            return false;
+        return is_record_root() ? finish() : true;
+    }
+
+    bool finish() {
+        json_record record{record_index_, std::move(record_key_), std::move(record_), {}};
+        record_ = nullptr;
+        if (validator_) {
+            record.validation = SchemaRegistry::validate(record.value, *validator_);
+            if (!field_pointers_.empty()) {
+                json picked;
+                for (const auto &pointer: field_pointers_) {
+                    if (record.value.contains(pointer))
+                        picked[pointer] = record.value.at(pointer);
+                }
+                record.value = std::move(picked);
+            }
+        }
+        delivered_++;
+        return callback_(record);
+    }
+
+    const json_record_callback &callback_;
+    const SchemaRegistry::Validator *validator_;
+    std::vector<std::string> records_;
+    std::vector<std::vector<std::string>> fields_;
+    std::vector<json::json_pointer> field_pointers_;
+    std::vector<Frame> frames_;
+    // depth of the skipped subtree being read
+    std::size_t skip_{0};
+    std::string token_;
+    json record_;
+    std::size_t record_index_{0};
+    std::string record_key_;
+    std::size_t record_frame_{0};
+    std::size_t delivered_{0};
+};
+
+} // namespace
+
+std::size_t stream_json_records(std::string_view text,
+                                const json_stream_options &options,
+                                const json_record_callback &callback) {
+    RecordReader reader(options, callback);
+    json::sax_parse(text.begin(), text.end(), &reader);
+    return reader.delivered();
+}
+
+std::size_t stream_json_file(const std::string &path,
+                             const json_stream_options &options,
+                             const json_record_callback &callback) {
+    MappedFile file(path, access_pattern::sequential);
+    return stream_json_records(file.view(), options, callback);
+}
+
+} // namespace utils::file
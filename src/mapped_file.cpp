@@ -0,0 +1,188 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <utility>
+#include <utils/mapped_file.h>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UTILS_HAS_MMAP 1
+#else
+#include <fstream>
+#define UTILS_HAS_MMAP 0
+#endif
+
+
+using std::runtime_error;
+
+namespace utils::file {
+
+namespace {
+
+runtime_error read_error(const std::string &path) {
+    return runtime_error(fmt::format("Error reading file at {0}: {1}", path, std::strerror(errno)));
+}
+
+#if UTILS_HAS_MMAP
+int advice_for(access_pattern pattern) {
+    switch (pattern) {
+        case access_pattern::sequential:
+            return MADV_SEQUENTIAL;
+        case access_pattern::random:
+            return MADV_RANDOM;
+        default:
+            return MADV_NORMAL;
+    }
+}
+
+// closes the descriptor on every path out of the constructor
+struct FileDescriptor {
+    int fd;
+
+    ~FileDescriptor() {
+        if (fd >= 0)
+            ::close(fd);
+    }
+};
+#endif
+
+} // namespace
+
+#if UTILS_HAS_MMAP
+MappedFile::MappedFile(const std::string &path, access_pattern pattern) {
+    FileDescriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    struct stat info{};
+    if (file.fd < 0 || ::fstat(file.fd, &info) != 0)
+        throw read_error(path);
+
+    // some regular files (/proc) report a size of zero and are read like pipes
+    if (S_ISREG(info.st_mode) && info.st_size > 0) {
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (void *address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file.fd, 0); address != MAP_FAILED) {
+            data_ = static_cast<const std::byte *>(address);
+            mapped_ = true;
+            advise(pattern);
+            return;
+        }
+        // mapping can fail on some file systems, read the known size in one go instead
+        buffer_ = std::make_unique_for_overwrite<std::byte[]>(size_);
+        std::size_t done = 0;
+        while (done < size_) {
+            auto n = ::read(file.fd, buffer_.get() + done, size_ - done);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                throw read_error(path);
+            done += static_cast<std::size_t>(n);
+        }
+        data_ = buffer_.get();
+        return;
+    }
+
+    // pipes and devices have no size up front, grow the buffer until the end of the file
+    std::size_t capacity = 1 << 16;
+    buffer_ = std::make_unique_for_overwrite<std::byte[]>(capacity);
+    while (true) {
+        if (size_ == capacity) {
+            auto grown = std::make_unique_for_overwrite<std::byte[]>(2 * capacity);
+            std::memcpy(grown.get(), buffer_.get(), size_);
+            buffer_ = std::move(grown);
+            capacity *= 2;
+        }
+        auto n = ::read(file.fd, buffer_.get() + size_, capacity - size_);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw read_error(path);
+        if (n == 0)
+            break;
+        size_ += static_cast<std::size_t>(n);
+    }
+    data_ = buffer_.get();
+}
+
+void MappedFile::advise(access_pattern pattern) const {
+    if (mapped_)
+        ::madvise(const_cast<std::byte *>(data_), size_, advice_for(pattern));
+}
+
+void MappedFile::release() {
+    if (mapped_)
+        ::munmap(const_cast<std::byte *>(data_), size_);
+    buffer_.reset();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+#else
+MappedFile::MappedFile(const std::string &path, access_pattern) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good())
+        throw read_error(path);
+    size_ = static_cast<std::size_t>(file.tellg());
+    buffer_ = std::make_unique_for_overwrite<std::byte[]>(size_);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(buffer_.get()), static_cast<std::streamsize>(size_)))
+        throw read_error(path);
+    data_ = buffer_.get();
+}
+
+void MappedFile::advise(access_pattern) const {}
+
+void MappedFile::release() {
+    buffer_.reset();
+    data_ = nullptr;
+    size_ = 0;
+}
+#endif
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          mapped_(std::exchange(other.mapped_, false)),
+          buffer_(std::move(other.buffer_)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+} // namespace utils::file
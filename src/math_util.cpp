@@ -24,9 +24,14 @@ SOFTWARE.
 
 
 #include <boost/iterator/function_output_iterator.hpp>
-#include <random>
+#include <cmath>
+#include <limits>
 #include <utility>
+#include <utils/bezier.h>
+#include <utils/binomial.h>
 #include <utils/math_util.h>
+#include <utils/point_generators.h>
+#include <utils/random.h>
 
 
 namespace utils::math {
@@ -35,124 +40,249 @@ using Kernel = CGAL::Simple_cartesian<double>;
 using TreeTraits = CGAL::Search_traits_2 <Kernel>;
 using  Neighbor_search = CGAL::Orthogonal_k_neighbor_search <TreeTraits>;
 
-std::vector<int *> generated_binomial_coeffs;
-int max_generated_degree = 0;
-
 int binomial_coeff(int n, int k) {
-    while (n >= max_generated_degree) {
-        int s = max_generated_degree;
-        int *coeffs = new int[s + 1];
-        coeffs[0] = 1;
-        for (int i = 1, prev = s - 1; i < s; i++)
-            coeffs[i] = generated_binomial_coeffs[prev][i - 1] + generated_binomial_coeffs[prev][i];
-        coeffs[s] = 1;
-        generated_binomial_coeffs.push_back(coeffs);
-        max_generated_degree++;
-        delete[] coeffs;
+    assert(n <= max_binomial_degree_int);
+    return static_cast<int>(binomial_coeff_u64(n, k));
+}
+
+namespace {
+
+// Bernstein weights per (degree, step size); they don't depend on the dimension, so one per-thread
+// cache serves every curve generator. A few entries cover the usual mix of cubics and quintics.
+const BezierCurve<1> &cached_bezier_weights(std::size_t degree, double step_size) {
+    constexpr std::size_t capacity = 8;
+    thread_local std::vector<BezierCurve<1>> cache;
+    thread_local std::size_t next_slot = 0;
+    for (const auto &curve : cache)
+        if (curve.degree() == degree && curve.step_size() == step_size)
+            return curve;
+    if (cache.size() < capacity) {
+        // reserved up front so returned references survive later insertions within a call
+        cache.reserve(capacity);
+        return cache.emplace_back(degree, step_size);
     }
+    auto &slot = cache[next_slot];
+    next_slot = (next_slot + 1) % capacity;
+    slot = BezierCurve<1>(degree, step_size);
+    return slot;
+}
 
-    return generated_binomial_coeffs[n][k];
+template <std::size_t Dim>
+std::size_t evaluate_bezier_curve(std::span<const float> control_points, double step_size, std::span<float> out) {
+    const std::size_t degree = control_points.size() / Dim - 1;
+    const auto &curve = cached_bezier_weights(degree, step_size);
+    assert(out.size() >= curve.sample_count() * Dim);
+    apply_bezier_weights<Dim>(curve.weights().data(), degree, curve.sample_count(), control_points.data(),
+                              out.data());
+    return curve.sample_count() * Dim;
 }
 
-std::vector<glm::vec2> generate_bezier_curve(std::vector<glm::vec2> control_points, double step_size) {
+// glm vectors are tightly packed floats, so their curves evaluate in place
+template <std::size_t Dim, typename Vec>
+std::size_t evaluate_bezier_curve(std::span<const Vec> control_points, double step_size, std::span<Vec> out) {
+    static_assert(sizeof(Vec) == Dim * sizeof(float));
     if (control_points.size() <= 2) {
-        return control_points;
-    }
-
-    std::vector<float> points;
-    for (auto p: control_points) {
-        points.push_back(p.x);
-        points.push_back(p.y);
+        assert(out.size() >= control_points.size());
+        std::copy(control_points.begin(), control_points.end(), out.begin());
+        return control_points.size();
     }
+    return evaluate_bezier_curve<Dim>(std::span<const float>(&control_points.front().x, Dim * control_points.size()),
+                                      step_size, std::span<float>(&out.front().x, Dim * out.size())) / Dim;
+}
 
-    std::vector<float> curve = generate_bezier_curve(points, step_size, 2);
+} // namespace
 
-    std::vector<glm::vec2> returnPoints;
-    for (int i = 0; i < curve.size() - 1; i += 2)
-        returnPoints.emplace_back(curve[i], curve[i + 1]);
+std::vector<glm::vec2> generate_bezier_curve(std::vector<glm::vec2> control_points, double step_size) {
+    std::vector<glm::vec2> result(bezier_curve_size(control_points.size(), step_size));
+    evaluate_bezier_curve<2>(std::span<const glm::vec2>(control_points), step_size, std::span<glm::vec2>(result));
+    return result;
+}
 
-    return returnPoints;
+std::size_t generate_bezier_curve(std::span<const glm::vec2> control_points, double step_size,
+                                  std::span<glm::vec2> out) {
+    return evaluate_bezier_curve<2>(control_points, step_size, out);
 }
 
 std::vector<glm::vec3> generate_bezier_curve(std::vector<glm::vec3> control_points, double step_size) {
-    if (control_points.size() <= 2) {
-        return control_points;
-    }
+    std::vector<glm::vec3> result(bezier_curve_size(control_points.size(), step_size));
+    evaluate_bezier_curve<3>(std::span<const glm::vec3>(control_points), step_size, std::span<glm::vec3>(result));
+    return result;
+}
 
-    auto points = std::vector<float>();
-    for (auto p: control_points) {
-        points.push_back(p.x);
-        points.push_back(p.y);
-        points.push_back(p.z);
-    }
+std::size_t generate_bezier_curve(std::span<const glm::vec3> control_points, double step_size,
+                                  std::span<glm::vec3> out) {
+    return evaluate_bezier_curve<3>(control_points, step_size, out);
+}
 
-    std::vector<float> curve = generate_bezier_curve(points, step_size, 3);
+std::size_t bezier_curve_size(std::size_t control_points, double step_size) {
+    return control_points <= 2 ? control_points : BezierCurve<1>::sample_count(step_size);
+}
 
-    std::vector<glm::vec3> returnPoints;
-    for (int i = 0; i < curve.size() - 2; i += 3)
-        returnPoints.emplace_back(curve[i], curve[i + 1], curve[i + 2]);
+std::vector<glm::vec2> flatten_bezier_curve(const std::vector<glm::vec2> &control_points, double tolerance) {
+    std::vector<glm::vec2> result;
+    if (control_points.empty())
+        return result;
+    flatten_bezier_curve<2, float>(std::span<const float>(&control_points.front().x, 2 * control_points.size()),
+                                   tolerance, [&](const float *p) { result.emplace_back(p[0], p[1]); });
+    return result;
+}
 
-    return returnPoints;
+std::vector<glm::vec3> flatten_bezier_curve(const std::vector<glm::vec3> &control_points, double tolerance) {
+    std::vector<glm::vec3> result;
+    if (control_points.empty())
+        return result;
+    flatten_bezier_curve<3, float>(std::span<const float>(&control_points.front().x, 3 * control_points.size()),
+                                   tolerance, [&](const float *p) { result.emplace_back(p[0], p[1], p[2]); });
+    return result;
 }
 
 std::vector<float> generate_bezier_curve(std::vector<float> control_points, double step_size, int dimension) {
+    std::vector<float> result(bezier_curve_size(control_points.size(), step_size, dimension));
+    generate_bezier_curve(std::span<const float>(control_points), step_size, dimension, std::span<float>(result));
+    return result;
+}
+
+std::size_t generate_bezier_curve(std::span<const float> control_points, double step_size, int dimension,
+                                  std::span<float> out) {
     if (control_points.size() <= 2) {
-        return control_points;
+        assert(out.size() >= control_points.size());
+        std::copy(control_points.begin(), control_points.end(), out.begin());
+        return control_points.size();
+    }
+
+#ifdef BEZIER_POLYNOMIAL
+    return bezier_polynomial(control_points, step_size, dimension, out);
+#else
+    switch (dimension) {
+        case 1:
+            return evaluate_bezier_curve<1>(control_points, step_size, out);
+        case 2:
+            return evaluate_bezier_curve<2>(control_points, step_size, out);
+        case 3:
+            return evaluate_bezier_curve<3>(control_points, step_size, out);
+        case 4:
+            return evaluate_bezier_curve<4>(control_points, step_size, out);
+        default:
+            return bezier_deCasteljau(control_points, step_size, dimension, out);
     }
+#endif
+}
 
+std::size_t bezier_curve_size(std::size_t control_values, double step_size, int dimension) {
+    if (control_values <= 2)
+        return control_values;
 #ifdef BEZIER_POLYNOMIAL
-    return bezierPolynomial(std::move(controlPoints), stepSize, dimension);
+    return bezier_polynomial_size(control_values, step_size, dimension);
 #else
-    return bezier_deCasteljau(std::move(control_points), step_size, dimension);
+    return BezierCurve<1>::sample_count(step_size) * dimension;
 #endif
 }
 
 std::vector<float> bezier_polynomial(std::vector<float> points, double step_size, int dimension) {
+    std::vector<float> curve(bezier_polynomial_size(points.size(), step_size, dimension));
+    bezier_polynomial(std::span<const float>(points), step_size, dimension, std::span<float>(curve));
+    return curve;
+}
+
+std::size_t bezier_polynomial(std::span<const float> points, double step_size, int dimension, std::span<float> out) {
+    const std::size_t size = bezier_polynomial_size(points.size(), step_size, dimension);
+    assert(out.size() >= size);
     // add first point to curve
-    std::vector<float> curve;
-    curve.insert(std::end(curve), std::begin(points), std::begin(points) + dimension);
+    float *curve = std::copy_n(points.begin(), dimension, out.data());
     int n = points.size() / dimension - 1;
     double t = step_size;
 
     while (t < 1.0) {
-        // setup output vector
-        std::vector<float> v;
-        v.reserve(dimension);
-        for (int i = 0; i < dimension; i++)
-            v.push_back(0);
-
+        std::fill_n(curve, dimension, 0.0f);
         double subT = 1.0 - t;
         for (int k = 0; k <= n; k++) {
             int subK = n - k;
-            double coeff = binomial_coeff(n, k) * std::pow(subT, subK) * std::pow(t, k);
+            double coeff = binomial_coeff_f64(n, k) * std::pow(subT, subK) * std::pow(t, k);
             // round to zero at threshold=0.001
             coeff = coeff > 0.001 ? coeff : 0;
             for (int i = 0; i < dimension; i++)
-                v[i] += points[k * dimension + i] * coeff;
+                curve[i] += points[k * dimension + i] * coeff;
         }
 
-        curve.insert(std::end(curve), std::begin(v), std::end(v));
+        curve += dimension;
         t += step_size;
     }
 
     // add last point to curve
-    curve.insert(std::end(curve), std::end(points) - dimension, std::end(points));
+    std::copy(points.end() - dimension, points.end(), curve);
+    return size;
+}
 
-    return curve;
+// first point, every t in [step_size, 1), last point
+std::size_t bezier_polynomial_size(std::size_t /*control_values*/, double step_size, int dimension) {
+    return (BezierCurve<1>::sample_count(step_size) + 1) * dimension;
+}
+
+std::vector<double> generate_binomial_matrix(int n) {
+    assert(n >= 0);
+    const std::size_t size = n + 1;
+    // B(k, n) = C(n, k) t^k (1 - t)^(n - k) = sum over i >= k of (-1)^(i - k) C(n, k) C(n - k, i - k) t^i
+    std::vector<double> matrix(size * size, 0.0);
+    for (int i = 0; i <= n; i++) {
+        for (int k = 0; k <= i; k++) {
+            double coeff = binomial_coeff_f64(n, k) * binomial_coeff_f64(n - k, i - k);
+            matrix[i * size + k] = (i - k) % 2 == 0 ? coeff : -coeff;
+        }
+    }
+    return matrix;
+}
+
+std::vector<float> bezier_matrix(std::vector<float> control_points, double step_size, int dimension) {
+    return bezier_matrix(control_points, 1, step_size, dimension);
+}
+
+std::vector<float> bezier_matrix(const std::vector<float> &control_points, std::size_t curves, double step_size,
+                                 int dimension) {
+    assert(dimension > 0 && curves > 0);
+    const std::size_t stride = control_points.size() / curves;
+    assert(stride * curves == control_points.size() && stride % dimension == 0 && stride > 0);
+    // the power basis times the characteristic matrix is exactly the Bernstein weight table, so the
+    // cached weights stand in for it
+    const std::size_t degree = stride / dimension - 1;
+    const auto &weights = cached_bezier_weights(degree, step_size);
+    const std::size_t out_stride = weights.sample_count() * dimension;
+    std::vector<float> result(curves * out_stride);
+
+    const float *in = control_points.data();
+    float *out = result.data();
+    for (std::size_t c = 0; c < curves; c++, in += stride, out += out_stride)
+        apply_bezier_weights(weights.weights().data(), degree, weights.sample_count(),
+                             static_cast<std::size_t>(dimension), in, out);
+    return result;
 }
 
 std::vector<float> bezier_deCasteljau(std::vector<float> points, double step_size, int dimension) {
+    std::vector<float> curve(bezier_deCasteljau_size(points.size(), step_size, dimension));
+    bezier_deCasteljau(std::span<const float>(points), step_size, dimension, std::span<float>(curve));
+    return curve;
+}
+
+std::size_t bezier_deCasteljau(std::span<const float> points, double step_size, int dimension, std::span<float> out) {
+    const std::size_t size = bezier_deCasteljau_size(points.size(), step_size, dimension);
+    assert(out.size() >= size);
+    // the levels of deCasteljau_kernel, reduced in place in a per-thread scratch buffer
+    thread_local std::vector<float> levels;
     // add first point to curve
-    std::vector<float> curve;
-    curve.insert(std::end(curve), std::begin(points), std::begin(points) + dimension);
-    double t = step_size;
-    while (t < 1.0) {
-        auto subCurve = deCasteljau_kernel(points, t, dimension);
-        curve.insert(std::end(curve), std::begin(subCurve), std::end(subCurve));
-        t += step_size;
+    float *curve = std::copy_n(points.begin(), dimension, out.data());
+    for (double t = step_size; t < 1.0; t += step_size) {
+        levels.assign(points.begin(), points.end());
+        for (std::size_t last = points.size() - dimension; last > 0; last -= dimension) {
+            for (std::size_t i = 0; i < last; i++)
+                levels[i] = (1 - t) * levels[i] + t * levels[i + dimension];
+        }
+        curve = std::copy_n(levels.begin(), dimension, curve);
     }
+    return size;
+}
 
-    return curve;
+// first point and every t in [step_size, 1)
+std::size_t bezier_deCasteljau_size(std::size_t /*control_values*/, double step_size, int dimension) {
+    return BezierCurve<1>::sample_count(step_size) * dimension;
 }
 
 std::vector<float> deCasteljau_kernel(std::vector<float> points, double t, int dimension) {
@@ -203,17 +333,31 @@ std::vector<glm::vec3> generate_box(double width, double height, double length)
 }
 
 std::vector<double> generate_parabola(std::vector<double> x, double a, double b, double c) {
-    std::vector<double> y;
-    for (auto i: x)
-        y.push_back(a * i * i + b * i + c);
+    std::vector<double> y(x.size());
+    generate_parabola(std::span<const double>(x), std::span<double>(y), a, b, c);
     return y;
 }
 
+std::size_t generate_parabola(std::span<const double> x, std::span<double> y, double a, double b, double c) {
+    assert(y.size() >= x.size());
+    for (std::size_t i = 0; i < x.size(); i++)
+        y[i] = a * x[i] * x[i] + b * x[i] + c;
+    return x.size();
+}
+
 double compute_parabola_y(glm::vec2 focus, double directrix_y, double x) {
+    return compute_parabola_y(glm::dvec2(focus), directrix_y, x);
+}
+
+double compute_parabola_y(glm::dvec2 focus, double directrix_y, double x) {
     return 0.5 * (glm::pow(x - focus.x, 2) / (focus.y - directrix_y) + (focus.y + directrix_y));
 }
 
 double compute_parabolic_collision_x(glm::vec2 left, glm::vec2 right, double directrix_y) {
+    return compute_parabolic_collision_x(glm::dvec2(left), glm::dvec2(right), directrix_y);
+}
+
+double compute_parabolic_collision_x(glm::dvec2 left, glm::dvec2 right, double directrix_y) {
     // ORDER OF PARAMS MATTERS
     double x1 = right.x, y1 = right.y, x2 = left.x, y2 = left.y;
     if(y1 == directrix_y) {
@@ -285,6 +429,49 @@ bool in_bounds(glm::vec2 p, bounds b) {
        && p.y < b.bottom_right.y;
 }
 
+namespace {
+
+// branch free so the loop vectorizes; the inputs are contiguous and the mask is written densely
+template <typename T>
+std::size_t in_box(std::span<const T> xs, std::span<const T> ys, T x0, T y0, T x1, T y1,
+                   std::span<std::uint8_t> mask) {
+    assert(ys.size() >= xs.size());
+    assert(mask.size() >= xs.size());
+    const T *px = xs.data(), *py = ys.data();
+    std::uint8_t *out = mask.data();
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        std::uint8_t inside = (px[i] >= x0) & (py[i] >= y0) & (px[i] < x1) & (py[i] < y1);
+        out[i] = inside;
+        hits += inside;
+    }
+    return hits;
+}
+
+// smallest float not below val, so float comparisons against it match the double comparison
+float float_ceil(double val) {
+    auto f = static_cast<float>(val);
+    return f < val ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+}
+
+} // namespace
+
+std::size_t in_rect(std::span<const double> xs, std::span<const double> ys, rect r, std::span<std::uint8_t> mask) {
+    return in_box(xs, ys, r.x, r.y, r.x + r.w, r.y + r.h, mask);
+}
+
+std::size_t in_rect(std::span<const float> xs, std::span<const float> ys, rect r, std::span<std::uint8_t> mask) {
+    return in_box(xs, ys, float_ceil(r.x), float_ceil(r.y), float_ceil(r.x + r.w), float_ceil(r.y + r.h), mask);
+}
+
+std::size_t in_bounds(std::span<const double> xs, std::span<const double> ys, bounds b, std::span<std::uint8_t> mask) {
+    return in_box<double>(xs, ys, b.top_left.x, b.top_left.y, b.bottom_right.x, b.bottom_right.y, mask);
+}
+
+std::size_t in_bounds(std::span<const float> xs, std::span<const float> ys, bounds b, std::span<std::uint8_t> mask) {
+    return in_box(xs, ys, b.top_left.x, b.top_left.y, b.bottom_right.x, b.bottom_right.y, mask);
+}
+
 bool check_overflow(double val) {
     return (val + 1.0) == val;
 }
@@ -311,14 +498,13 @@ bool on_segment(glm::vec2 p, glm::vec2 q, glm::vec2 r)
 // 2 --> Counterclockwise
 int orientation(glm::vec2 p, glm::vec2 q, glm::vec2 r)
 {
-    // See https://www.geeksforgeeks.org/orientation-3-ordered-points/
-    // for details of below formula.
-    int val = (q.y - p.y) * (r.x - q.x) -
-              (q.x - p.x) * (r.y - q.y);
+    // the float cross product used to be truncated to int, which called every
+    // small or nearly colinear triplet colinear; the sign is now exact
+    auto val = orient2d(p, q, r);
 
     if (val == 0) return 0;  // colinear
 
-    return (val > 0)? 1: 2; // clock or counterclock wise
+    return (val < 0)? 1: 2; // clock or counterclock wise
 }
 
 // Reference: https://www.geeksforgeeks.org/check-if-two-given-line-segments-intersect/
@@ -353,8 +539,95 @@ bool do_intersect(glm::vec2 p1, glm::vec2 q1, glm::vec2 p2, glm::vec2 q2)
     return false; // Doesn't fall in any of the above cases
 }
 
+// Adaptive cross product in the style of Shewchuk's orient2d: the plain double
+// evaluation is kept when its error bound proves the sign, otherwise every
+// difference and product is expanded exactly and summed without rounding.
+namespace {
+
+void two_sum(double a, double b, double& x, double& y) {
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+void two_diff(double a, double b, double& x, double& y) {
+    x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    y = (a - av) + (bv - b);
+}
+
+void two_product(double a, double b, double& x, double& y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// e holds a nonoverlapping expansion of increasing magnitude, grown in place by b
+std::size_t grow_expansion(double* e, std::size_t length, double b) {
+    for (std::size_t i = 0; i < length; ++i)
+        two_sum(b, e[i], b, e[i]);
+    e[length] = b;
+    return length + 1;
+}
+
+double exact_cross(double ax1, double ax0, double ay1, double ay0,
+                   double bx1, double bx0, double by1, double by0) {
+    double ax[2], ay[2], bx[2], by[2];
+    two_diff(ax1, ax0, ax[1], ax[0]);
+    two_diff(ay1, ay0, ay[1], ay[0]);
+    two_diff(bx1, bx0, bx[1], bx[0]);
+    two_diff(by1, by0, by[1], by[0]);
+
+    double terms[16];
+    std::size_t length = 0;
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            double hi, lo;
+            two_product(ax[i], by[j], hi, lo);
+            length = grow_expansion(terms, length, lo);
+            length = grow_expansion(terms, length, hi);
+            two_product(ay[i], bx[j], hi, lo);
+            length = grow_expansion(terms, length, -lo);
+            length = grow_expansion(terms, length, -hi);
+        }
+    }
+    // the most significant nonzero component carries the sign
+    for (std::size_t i = length; i-- > 0;)
+        if (terms[i] != 0)
+            return terms[i];
+    return 0;
+}
+
+double adaptive_cross(double ax1, double ax0, double ay1, double ay0,
+                      double bx1, double bx0, double by1, double by0) {
+    constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2;
+    constexpr double error_bound = (3.0 + 16.0 * epsilon) * epsilon;
+
+    double left = (ax1 - ax0) * (by1 - by0);
+    double right = (ay1 - ay0) * (bx1 - bx0);
+    double det = left - right;
+    if (std::abs(det) > error_bound * (std::abs(left) + std::abs(right)))
+        return det;
+    return exact_cross(ax1, ax0, ay1, ay0, bx1, bx0, by1, by0);
+}
+
+} // namespace
+
+double orient2d(glm::dvec2 p, glm::dvec2 q, glm::dvec2 r) {
+    return adaptive_cross(q.x, p.x, q.y, p.y, r.x, p.x, r.y, p.y);
+}
+
+double cross2d(glm::dvec2 a0, glm::dvec2 a1, glm::dvec2 b0, glm::dvec2 b1) {
+    return adaptive_cross(a1.x, a0.x, a1.y, a0.y, b1.x, b0.x, b1.y, b0.y);
+}
+
 // Reference: https://mapbox.github.io/delaunator : circumcenter function
 glm::vec2 compute_triangle_circumcenter(glm::vec2 a, glm::vec2 b, glm::vec2 c) {
+    return glm::vec2(compute_triangle_circumcenter(glm::dvec2(a), glm::dvec2(b), glm::dvec2(c)));
+}
+
+glm::dvec2 compute_triangle_circumcenter(glm::dvec2 a, glm::dvec2 b, glm::dvec2 c) {
     auto ad = a[0] * a[0] + a[1] * a[1];
     auto bd = b[0] * b[0] + b[1] * b[1];
     auto cd = c[0] * c[0] + c[1] * c[1];
@@ -366,18 +639,16 @@ glm::vec2 compute_triangle_circumcenter(glm::vec2 a, glm::vec2 b, glm::vec2 c) {
 }
 
 std::vector<Point_2> generate_points(unsigned int num_points, unsigned int width, unsigned int height) {
+    return generate_points(num_points, width, height, random::thread_generator()());
+}
+
+std::vector<Point_2> generate_points(unsigned int num_points, unsigned int width, unsigned int height,
+                                     std::uint64_t seed) {
     assert(width > 0);
     assert(height > 0);
-    std::random_device rd;
-    std::set<Point_2> points;
-    while (points.size() < num_points) {
-        Point_2 v;
-        do {
-            v = Point_2(rd() % width, rd() % height);
-        } while (points.contains(v));
-        points.insert(v);
-    }
-    return {points.begin(), points.end()};
+    std::vector<Point_2> points(num_points);
+    generate_lattice_points(points, width, height, seed);
+    return points;
 }
 
 std::vector<Point_2> convert_to_point_2(const std::vector<double>& coords) {
@@ -389,7 +660,7 @@ std::vector<Point_2> convert_to_point_2(const std::vector<double>& coords) {
 }
 
 float uniform_random(float a, float b) {
-    return a + (b - a) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+    return a + (b - a) * random::thread_generator().next_float();
 }
 
 } // namespace utils::math
@@ -0,0 +1,259 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utils/mesh.h>
+
+
+namespace utils::math {
+
+namespace {
+
+constexpr unsigned int known_attributes = mesh_normals | mesh_uvs;
+
+unsigned int attributes_of(const mesh_view &out) {
+    return (out.normals.empty() ? 0u : mesh_normals) | (out.uvs.empty() ? 0u : mesh_uvs);
+}
+
+// appends vertices and triangles to a mesh_view sized for them up front
+class MeshWriter {
+public:
+    MeshWriter(mesh_view out, mesh_size size) : out_(out) {
+        assert(size.vertices <= std::numeric_limits<std::uint32_t>::max());
+        assert(out.positions.size() == size.vertices);
+        assert(out.normals.empty() || out.normals.size() == size.vertices);
+        assert(out.uvs.empty() || out.uvs.size() == size.vertices);
+        assert(out.indices.size() == size.indices);
+    }
+
+    std::uint32_t vertex(glm::dvec3 position, glm::dvec3 normal, glm::dvec2 uv) {
+        out_.positions[vertices_] = glm::vec3(position);
+        if (!out_.normals.empty())
+            out_.normals[vertices_] = glm::vec3(normal);
+        if (!out_.uvs.empty())
+            out_.uvs[vertices_] = glm::vec2(uv);
+        return static_cast<std::uint32_t>(vertices_++);
+    }
+
+    void triangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+        out_.indices[indices_++] = a;
+        out_.indices[indices_++] = b;
+        out_.indices[indices_++] = c;
+    }
+
+    [[nodiscard]]
+    bool full() const {
+        return vertices_ == out_.positions.size() && indices_ == out_.indices.size();
+    }
+
+private:
+    mesh_view out_;
+    std::size_t vertices_{0};
+    std::size_t indices_{0};
+};
+
+indexed_mesh allocate_mesh(mesh_size size, unsigned int attributes) {
+    indexed_mesh mesh;
+    mesh.positions.resize(size.vertices);
+    if (attributes & mesh_normals)
+        mesh.normals.resize(size.vertices);
+    if (attributes & mesh_uvs)
+        mesh.uvs.resize(size.vertices);
+    mesh.indices.resize(size.indices);
+    return mesh;
+}
+
+} // namespace
+
+mesh_size sphere_mesh_size(unsigned int slices, unsigned int stacks, unsigned int attributes) {
+    assert(slices >= 3 && stacks >= 2);
+    std::size_t rings = stacks - 1;
+    std::size_t indices = 6 * std::size_t{slices} * rings;
+    // the uv seam repeats the first column and each pole is split per slice
+    if (attributes & mesh_uvs)
+        return {(slices + std::size_t{1}) * rings + 2 * std::size_t{slices}, indices};
+    return {slices * rings + 2, indices};
+}
+
+void generate_sphere_mesh(double radius, unsigned int slices, unsigned int stacks, mesh_view out) {
+    MeshWriter mesh(out, sphere_mesh_size(slices, stacks, attributes_of(out)));
+    bool seam = !out.uvs.empty();
+    std::uint32_t columns = slices + seam;
+    std::uint32_t poles = seam ? slices : 1;
+
+    auto add_poles = [&](double z, double v) {
+        for (std::uint32_t j = 0; j < poles; ++j)
+            mesh.vertex({0, 0, radius * z}, {0, 0, z}, {(j + 0.5) / slices, v});
+    };
+    add_poles(1, 0);
+    for (unsigned int i = 1; i < stacks; ++i) {
+        double theta = std::numbers::pi * i / stacks;
+        for (std::uint32_t j = 0; j < columns; ++j) {
+            double phi = 2 * std::numbers::pi * (j % slices) / slices;
+            glm::dvec3 normal(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+            mesh.vertex(radius * normal, normal, {static_cast<double>(j) / slices, static_cast<double>(i) / stacks});
+        }
+    }
+    std::uint32_t south = poles + columns * (stacks - 1);
+    add_poles(-1, 1);
+
+    auto ring = [&](unsigned int i, std::uint32_t j) {
+        return poles + (i - 1) * columns + (seam ? j : j % slices);
+    };
+    for (std::uint32_t j = 0; j < slices; ++j) {
+        mesh.triangle(seam ? j : 0, ring(1, j), ring(1, j + 1));
+        for (unsigned int i = 1; i + 1 < stacks; ++i) {
+            mesh.triangle(ring(i, j), ring(i + 1, j), ring(i + 1, j + 1));
+            mesh.triangle(ring(i, j), ring(i + 1, j + 1), ring(i, j + 1));
+        }
+        mesh.triangle(ring(stacks - 1, j), south + (seam ? j : 0), ring(stacks - 1, j + 1));
+    }
+    assert(mesh.full());
+}
+
+indexed_mesh generate_sphere_mesh(double radius, unsigned int slices, unsigned int stacks, unsigned int attributes) {
+    auto mesh = allocate_mesh(sphere_mesh_size(slices, stacks, attributes), attributes);
+    generate_sphere_mesh(radius, slices, stacks, mesh.view());
+    return mesh;
+}
+
+mesh_size cylinder_mesh_size(unsigned int slices, unsigned int stacks, unsigned int attributes) {
+    assert(slices >= 3 && stacks >= 1);
+    std::size_t columns = slices + ((attributes & mesh_uvs) ? 1 : 0);
+    // caps share the side rims unless they carry their own normals or uvs
+    std::size_t caps = (attributes & known_attributes) ? 2 * (slices + std::size_t{1}) : 2;
+    return {columns * (stacks + 1) + caps, 6 * std::size_t{slices} * (stacks + 1)};
+}
+
+void generate_cylinder_mesh(double radius, double length, unsigned int slices, unsigned int stacks, mesh_view out) {
+    auto attributes = attributes_of(out);
+    MeshWriter mesh(out, cylinder_mesh_size(slices, stacks, attributes));
+    bool seam = !out.uvs.empty();
+    bool split = attributes != 0;
+    std::uint32_t columns = slices + seam;
+
+    for (unsigned int k = 0; k <= stacks; ++k) {
+        double z = length * k / stacks;
+        for (std::uint32_t j = 0; j < columns; ++j) {
+            double phi = 2 * std::numbers::pi * (j % slices) / slices;
+            glm::dvec3 normal(std::cos(phi), std::sin(phi), 0);
+            mesh.vertex({radius * normal.x, radius * normal.y, z}, normal,
+                        {static_cast<double>(j) / slices, static_cast<double>(k) / stacks});
+        }
+    }
+    auto side = [&](unsigned int k, std::uint32_t j) {
+        return k * columns + (seam ? j : j % slices);
+    };
+
+    auto add_cap = [&](double z, double nz) {
+        auto center = mesh.vertex({0, 0, z}, {0, 0, nz}, {0.5, 0.5});
+        if (split) {
+            for (std::uint32_t j = 0; j < slices; ++j) {
+                double phi = 2 * std::numbers::pi * j / slices;
+                double c = std::cos(phi), s = std::sin(phi);
+                mesh.vertex({radius * c, radius * s, z}, {0, 0, nz}, {0.5 + 0.5 * c, 0.5 + 0.5 * nz * s});
+            }
+        }
+        return center;
+    };
+    auto bottom = add_cap(0, -1);
+    auto top = add_cap(length, 1);
+    auto rim = [&](std::uint32_t center, unsigned int k, std::uint32_t j) {
+        return split ? center + 1 + j % slices : side(k, j % slices);
+    };
+
+    for (std::uint32_t j = 0; j < slices; ++j) {
+        mesh.triangle(bottom, rim(bottom, 0, j + 1), rim(bottom, 0, j));
+        for (unsigned int k = 0; k < stacks; ++k) {
+            mesh.triangle(side(k, j), side(k, j + 1), side(k + 1, j + 1));
+            mesh.triangle(side(k, j), side(k + 1, j + 1), side(k + 1, j));
+        }
+        mesh.triangle(top, rim(top, stacks, j), rim(top, stacks, j + 1));
+    }
+    assert(mesh.full());
+}
+
+indexed_mesh generate_cylinder_mesh(double radius, double length, unsigned int slices, unsigned int stacks,
+                                    unsigned int attributes) {
+    auto mesh = allocate_mesh(cylinder_mesh_size(slices, stacks, attributes), attributes);
+    generate_cylinder_mesh(radius, length, slices, stacks, mesh.view());
+    return mesh;
+}
+
+mesh_size box_mesh_size(unsigned int attributes) {
+    return {(attributes & known_attributes) ? 24u : 8u, 36};
+}
+
+void generate_box_mesh(double width, double height, double length, mesh_view out) {
+    // corners in generate_box order, faces counterclockwise from outside
+    constexpr int faces[6][4] = {
+            {0, 3, 2, 1}, {4, 5, 6, 7},
+            {0, 1, 5, 4}, {3, 7, 6, 2},
+            {0, 4, 7, 3}, {1, 2, 6, 5}
+    };
+    constexpr glm::dvec3 normals[6] = {
+            {0, 0, -1}, {0, 0, 1},
+            {0, -1, 0}, {0, 1, 0},
+            {-1, 0, 0}, {1, 0, 0}
+    };
+    constexpr glm::dvec2 uvs[4] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    const glm::dvec3 corners[8] = {
+            {0, 0, 0}, {width, 0, 0}, {width, height, 0}, {0, height, 0},
+            {0, 0, length}, {width, 0, length}, {width, height, length}, {0, height, length}
+    };
+
+    auto attributes = attributes_of(out);
+    MeshWriter mesh(out, box_mesh_size(attributes));
+    if (attributes == 0) {
+        for (const auto &corner : corners)
+            mesh.vertex(corner, {}, {});
+        for (const auto &face : faces) {
+            mesh.triangle(face[0], face[1], face[2]);
+            mesh.triangle(face[0], face[2], face[3]);
+        }
+    } else {
+        for (int f = 0; f < 6; ++f) {
+            std::uint32_t first = 0;
+            for (int c = 0; c < 4; ++c) {
+                auto v = mesh.vertex(corners[faces[f][c]], normals[f], uvs[c]);
+                if (c == 0)
+                    first = v;
+            }
+            mesh.triangle(first, first + 1, first + 2);
+            mesh.triangle(first, first + 2, first + 3);
+        }
+    }
+    assert(mesh.full());
+}
+
+indexed_mesh generate_box_mesh(double width, double height, double length, unsigned int attributes) {
+    auto mesh = allocate_mesh(box_mesh_size(attributes), attributes);
+    generate_box_mesh(width, height, length, mesh.view());
+    return mesh;
+}
+
+} // namespace utils::math
@@ -0,0 +1,275 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cassert>
+#include <limits>
+#include <utils/point_cloud.h>
+
+
+namespace utils::math {
+
+namespace {
+
+// Reductions keep one accumulator per lane so they vectorize without -ffast-math
+constexpr std::size_t lanes = 8;
+
+void min_max(std::span<const float> values, float &lo, float &hi) {
+    float mins[lanes], maxs[lanes];
+    for (std::size_t l = 0; l < lanes; ++l) {
+        mins[l] = std::numeric_limits<float>::infinity();
+        maxs[l] = -std::numeric_limits<float>::infinity();
+    }
+    const float *v = values.data();
+    std::size_t n = values.size(), i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            mins[l] = v[i + l] < mins[l] ? v[i + l] : mins[l];
+            maxs[l] = v[i + l] > maxs[l] ? v[i + l] : maxs[l];
+        }
+    }
+    for (; i < n; ++i) {
+        mins[0] = v[i] < mins[0] ? v[i] : mins[0];
+        maxs[0] = v[i] > maxs[0] ? v[i] : maxs[0];
+    }
+    lo = mins[0];
+    hi = maxs[0];
+    for (std::size_t l = 1; l < lanes; ++l) {
+        lo = mins[l] < lo ? mins[l] : lo;
+        hi = maxs[l] > hi ? maxs[l] : hi;
+    }
+}
+
+// summed in double so the centroid of a large cloud does not drift
+double sum(std::span<const float> values) {
+    double sums[lanes] = {};
+    const float *v = values.data();
+    std::size_t n = values.size(), i = 0;
+    for (; i + lanes <= n; i += lanes)
+        for (std::size_t l = 0; l < lanes; ++l)
+            sums[l] += v[i + l];
+    for (; i < n; ++i)
+        sums[0] += v[i];
+    double total = 0;
+    for (double s : sums)
+        total += s;
+    return total;
+}
+
+float mean(std::span<const float> values) {
+    return values.empty() ? 0.0f : static_cast<float>(sum(values) / static_cast<double>(values.size()));
+}
+
+void scale_and_offset(std::span<float> values, float factor, float offset) {
+    float *v = values.data();
+    for (std::size_t i = 0; i < values.size(); ++i)
+        v[i] = v[i] * factor + offset;
+}
+
+} // namespace
+
+PointCloud2D::PointCloud2D(std::size_t size) : xs_(size), ys_(size) {}
+
+PointCloud2D::PointCloud2D(std::span<const glm::vec2> points) : xs_(points.size()), ys_(points.size()) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        xs_[i] = points[i].x;
+        ys_[i] = points[i].y;
+    }
+}
+
+PointCloud2D::PointCloud2D(std::span<const Point_2> points) : xs_(points.size()), ys_(points.size()) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        xs_[i] = static_cast<float>(points[i].x());
+        ys_[i] = static_cast<float>(points[i].y());
+    }
+}
+
+void PointCloud2D::resize(std::size_t size) {
+    xs_.resize(size);
+    ys_.resize(size);
+}
+
+void PointCloud2D::reserve(std::size_t size) {
+    xs_.reserve(size);
+    ys_.reserve(size);
+}
+
+void PointCloud2D::clear() {
+    xs_.clear();
+    ys_.clear();
+}
+
+void PointCloud2D::push_back(glm::vec2 point) {
+    xs_.push_back(point.x);
+    ys_.push_back(point.y);
+}
+
+bounds PointCloud2D::bounding_box() const {
+    bounds b{};
+    min_max(xs_, b.top_left.x, b.bottom_right.x);
+    min_max(ys_, b.top_left.y, b.bottom_right.y);
+    return b;
+}
+
+glm::vec2 PointCloud2D::centroid() const {
+    return {mean(xs_), mean(ys_)};
+}
+
+void PointCloud2D::transform(const glm::mat3 &m) {
+    const float m00 = m[0][0], m01 = m[1][0], m02 = m[2][0];
+    const float m10 = m[0][1], m11 = m[1][1], m12 = m[2][1];
+    float *px = xs_.data(), *py = ys_.data();
+    for (std::size_t i = 0; i < xs_.size(); ++i) {
+        float x = px[i], y = py[i];
+        px[i] = m00 * x + m01 * y + m02;
+        py[i] = m10 * x + m11 * y + m12;
+    }
+}
+
+void PointCloud2D::translate(glm::vec2 offset) {
+    scale_and_offset(xs_, 1.0f, offset.x);
+    scale_and_offset(ys_, 1.0f, offset.y);
+}
+
+void PointCloud2D::scale(glm::vec2 factor) {
+    scale_and_offset(xs_, factor.x, 0.0f);
+    scale_and_offset(ys_, factor.y, 0.0f);
+}
+
+std::size_t PointCloud2D::in_rect(rect r, std::span<std::uint8_t> mask) const {
+    return math::in_rect(xs(), ys(), r, mask);
+}
+
+std::size_t PointCloud2D::in_bounds(bounds b, std::span<std::uint8_t> mask) const {
+    return math::in_bounds(xs(), ys(), b, mask);
+}
+
+std::vector<glm::vec2> PointCloud2D::to_vec2() const {
+    std::vector<glm::vec2> points(size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+        points[i] = {xs_[i], ys_[i]};
+    return points;
+}
+
+std::vector<Point_2> PointCloud2D::to_point_2() const {
+    std::vector<Point_2> points;
+    points.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i)
+        points.emplace_back(xs_[i], ys_[i]);
+    return points;
+}
+
+PointCloud3D::PointCloud3D(std::size_t size) : xs_(size), ys_(size), zs_(size) {}
+
+PointCloud3D::PointCloud3D(std::span<const glm::vec3> points)
+        : xs_(points.size()), ys_(points.size()), zs_(points.size()) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        xs_[i] = points[i].x;
+        ys_[i] = points[i].y;
+        zs_[i] = points[i].z;
+    }
+}
+
+void PointCloud3D::resize(std::size_t size) {
+    xs_.resize(size);
+    ys_.resize(size);
+    zs_.resize(size);
+}
+
+void PointCloud3D::reserve(std::size_t size) {
+    xs_.reserve(size);
+    ys_.reserve(size);
+    zs_.reserve(size);
+}
+
+void PointCloud3D::clear() {
+    xs_.clear();
+    ys_.clear();
+    zs_.clear();
+}
+
+void PointCloud3D::push_back(glm::vec3 point) {
+    xs_.push_back(point.x);
+    ys_.push_back(point.y);
+    zs_.push_back(point.z);
+}
+
+bounds_3 PointCloud3D::bounding_box() const {
+    bounds_3 b{};
+    min_max(xs_, b.min.x, b.max.x);
+    min_max(ys_, b.min.y, b.max.y);
+    min_max(zs_, b.min.z, b.max.z);
+    return b;
+}
+
+glm::vec3 PointCloud3D::centroid() const {
+    return {mean(xs_), mean(ys_), mean(zs_)};
+}
+
+void PointCloud3D::transform(const glm::mat4 &m) {
+    const float m00 = m[0][0], m01 = m[1][0], m02 = m[2][0], m03 = m[3][0];
+    const float m10 = m[0][1], m11 = m[1][1], m12 = m[2][1], m13 = m[3][1];
+    const float m20 = m[0][2], m21 = m[1][2], m22 = m[2][2], m23 = m[3][2];
+    float *px = xs_.data(), *py = ys_.data(), *pz = zs_.data();
+    for (std::size_t i = 0; i < xs_.size(); ++i) {
+        float x = px[i], y = py[i], z = pz[i];
+        px[i] = m00 * x + m01 * y + m02 * z + m03;
+        py[i] = m10 * x + m11 * y + m12 * z + m13;
+        pz[i] = m20 * x + m21 * y + m22 * z + m23;
+    }
+}
+
+void PointCloud3D::translate(glm::vec3 offset) {
+    scale_and_offset(xs_, 1.0f, offset.x);
+    scale_and_offset(ys_, 1.0f, offset.y);
+    scale_and_offset(zs_, 1.0f, offset.z);
+}
+
+void PointCloud3D::scale(glm::vec3 factor) {
+    scale_and_offset(xs_, factor.x, 0.0f);
+    scale_and_offset(ys_, factor.y, 0.0f);
+    scale_and_offset(zs_, factor.z, 0.0f);
+}
+
+std::size_t PointCloud3D::in_bounds(bounds_3 b, std::span<std::uint8_t> mask) const {
+    assert(mask.size() >= size());
+    const float *px = xs_.data(), *py = ys_.data(), *pz = zs_.data();
+    std::uint8_t *out = mask.data();
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < xs_.size(); ++i) {
+        std::uint8_t inside = (px[i] >= b.min.x) & (py[i] >= b.min.y) & (pz[i] >= b.min.z) &
+                              (px[i] < b.max.x) & (py[i] < b.max.y) & (pz[i] < b.max.z);
+        out[i] = inside;
+        hits += inside;
+    }
+    return hits;
+}
+
+std::vector<glm::vec3> PointCloud3D::to_vec3() const {
+    std::vector<glm::vec3> points(size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+        points[i] = {xs_[i], ys_[i], zs_[i]};
+    return points;
+}
+
+} // namespace utils::math
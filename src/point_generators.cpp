@@ -0,0 +1,143 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <utils/flat_hash.h>
+#include <utils/point_generators.h>
+#include <utils/random.h>
+
+
+namespace utils::math {
+
+void generate_uniform_points(std::span<Point_2> out, double width, double height, std::uint64_t seed) {
+    random::Xoshiro256 rng(seed);
+    for (auto &p: out) {
+        double x = rng.next_double() * width;
+        p = Point_2(x, rng.next_double() * height);
+    }
+}
+
+void generate_lattice_points(std::span<Point_2> out, unsigned int width, unsigned int height, std::uint64_t seed) {
+    const std::uint64_t cells = std::uint64_t{width} * height;
+    assert(out.size() <= cells);
+    random::Xoshiro256 rng(seed);
+    // Floyd's algorithm: exactly one draw per point, however full the lattice gets
+    FlatHashSet<std::uint64_t, MixHash> taken(out.size());
+    std::size_t i = 0;
+    for (auto j = cells - out.size(); j < cells; j++) {
+        auto cell = rng.next_below(j + 1);
+        if (!taken.insert(cell)) {
+            cell = j;
+            taken.insert(cell);
+        }
+        out[i++] = Point_2(static_cast<double>(cell % width), static_cast<double>(cell / width));
+    }
+}
+
+void generate_jittered_grid(std::span<Point_2> out, unsigned int cols, unsigned int rows,
+                            double width, double height, double jitter, std::uint64_t seed) {
+    assert(out.size() == std::size_t{cols} * rows);
+    random::Xoshiro256 rng(seed);
+    const double cell_w = width / cols, cell_h = height / rows;
+    std::size_t i = 0;
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int col = 0; col < cols; col++) {
+            double x = (col + 0.5 + jitter * (rng.next_double() - 0.5)) * cell_w;
+            double y = (row + 0.5 + jitter * (rng.next_double() - 0.5)) * cell_h;
+            out[i++] = Point_2(x, y);
+        }
+    }
+}
+
+std::size_t generate_poisson_disk(std::vector<Point_2> &out, double width, double height, double min_distance,
+                                  std::uint64_t seed, unsigned int attempts) {
+    assert(min_distance > 0);
+    if (!(width > 0 && height > 0))
+        return 0;
+    random::Xoshiro256 rng(seed);
+    const std::size_t start = out.size();
+    // cells small enough to hold at most one sample
+    const double cell = min_distance / std::sqrt(2.0);
+    const auto cols = static_cast<long>(std::ceil(width / cell));
+    const auto rows = static_cast<long>(std::ceil(height / cell));
+    std::vector<long> grid(static_cast<std::size_t>(cols * rows), -1);
+    std::vector<long> active;
+    const double sq_min = min_distance * min_distance;
+
+    // clamped, as x / cell can round up to cols just below width
+    auto column = [&](double x) {
+        return std::clamp(static_cast<long>(x / cell), 0L, cols - 1);
+    };
+    auto row = [&](double y) {
+        return std::clamp(static_cast<long>(y / cell), 0L, rows - 1);
+    };
+    auto add = [&](double x, double y) {
+        auto id = static_cast<long>(out.size());
+        out.emplace_back(x, y);
+        grid[row(y) * cols + column(x)] = id;
+        active.push_back(id);
+    };
+    auto fits = [&](double x, double y) {
+        auto cx = column(x), cy = row(y);
+        for (auto gy = std::max(cy - 2, 0L); gy <= std::min(cy + 2, rows - 1); gy++) {
+            for (auto gx = std::max(cx - 2, 0L); gx <= std::min(cx + 2, cols - 1); gx++) {
+                auto id = grid[gy * cols + gx];
+                if (id < 0)
+                    continue;
+                double dx = out[id].x() - x, dy = out[id].y() - y;
+                if (dx * dx + dy * dy < sq_min)
+                    return false;
+            }
+        }
+        return true;
+    };
+
+    add(rng.next_double() * width, rng.next_double() * height);
+    while (!active.empty()) {
+        auto slot = rng.next_below(active.size());
+        const Point_2 origin = out[active[slot]];
+        bool placed = false;
+        for (unsigned int i = 0; i < attempts && !placed; i++) {
+            // uniform by area over the annulus [r, 2r)
+            double radius = min_distance * std::sqrt(1.0 + 3.0 * rng.next_double());
+            double angle = 2.0 * std::numbers::pi * rng.next_double();
+            double x = origin.x() + radius * std::cos(angle);
+            double y = origin.y() + radius * std::sin(angle);
+            if (x >= 0 && y >= 0 && x < width && y < height && fits(x, y)) {
+                add(x, y);
+                placed = true;
+            }
+        }
+        if (!placed) {
+            active[slot] = active.back();
+            active.pop_back();
+        }
+    }
+    return out.size() - start;
+}
+
+} // namespace utils::math
@@ -0,0 +1,376 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <utils/point_index.h>
+
+
+namespace utils::math {
+
+namespace {
+
+template <typename Node>
+double box_sq_distance(const Node &node, double x, double y) {
+    double dx = std::max({node.min_x - x, 0.0, x - node.max_x});
+    double dy = std::max({node.min_y - y, 0.0, y - node.max_y});
+    return dx * dx + dy * dy;
+}
+
+// half-open box described by either a rect or bounds; leaves are scanned with the matching batch test
+template <typename Shape>
+struct BoxRegion {
+    BoxRegion(rect r) : shape(r), x0(r.x), y0(r.y), x1(r.x + r.w), y1(r.y + r.h) {}
+
+    BoxRegion(bounds b) : shape(b), x0(b.top_left.x), y0(b.top_left.y), x1(b.bottom_right.x), y1(b.bottom_right.y) {}
+
+    template <typename Node>
+    bool disjoint(const Node &node) const {
+        return node.max_x < x0 || node.max_y < y0 || node.min_x >= x1 || node.min_y >= y1;
+    }
+
+    template <typename Node>
+    bool covers(const Node &node) const {
+        return node.min_x >= x0 && node.min_y >= y0 && node.max_x < x1 && node.max_y < y1;
+    }
+
+    bool contains(const Point_2 &p) const {
+        if constexpr (std::is_same_v<Shape, rect>)
+            return in_rect(p, shape);
+        else
+            return in_bounds(p, shape);
+    }
+
+    std::size_t scan(std::span<const double> xs, std::span<const double> ys, std::span<std::uint8_t> mask) const {
+        if constexpr (std::is_same_v<Shape, rect>)
+            return in_rect(xs, ys, shape, mask);
+        else
+            return in_bounds(xs, ys, shape, mask);
+    }
+
+    Shape shape;
+    double x0, y0, x1, y1;
+};
+
+struct RadiusRegion {
+    double x, y, sq_radius;
+
+    template <typename Node>
+    bool disjoint(const Node &node) const {
+        return box_sq_distance(node, x, y) > sq_radius;
+    }
+
+    template <typename Node>
+    bool covers(const Node &node) const {
+        double dx = std::max(x - node.min_x, node.max_x - x);
+        double dy = std::max(y - node.min_y, node.max_y - y);
+        return dx * dx + dy * dy <= sq_radius;
+    }
+
+    bool contains(const Point_2 &p) const {
+        double dx = p.x() - x, dy = p.y() - y;
+        return dx * dx + dy * dy <= sq_radius;
+    }
+
+    std::size_t scan(std::span<const double> xs, std::span<const double> ys, std::span<std::uint8_t> mask) const {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < xs.size(); i++) {
+            double dx = xs[i] - x, dy = ys[i] - y;
+            std::uint8_t inside = dx * dx + dy * dy <= sq_radius;
+            mask[i] = inside;
+            hits += inside;
+        }
+        return hits;
+    }
+};
+
+} // namespace
+
+PointIndex2D::PointIndex2D(std::vector<Point_2> points) {
+    rebuild(std::move(points));
+}
+
+void PointIndex2D::rebuild(std::vector<Point_2> points) {
+    points_ = std::move(points);
+    rebuild();
+}
+
+void PointIndex2D::rebuild() {
+    assert(points_.size() < std::numeric_limits<std::uint32_t>::max());
+    indexed_ = points_.size();
+    nodes_.clear();
+    order_.resize(indexed_);
+    for (std::uint32_t i = 0; i < indexed_; i++)
+        order_[i] = i;
+    if (indexed_ > 0) {
+        nodes_.reserve(2 * (indexed_ / leaf_size + 1));
+        build(0, static_cast<std::uint32_t>(indexed_));
+    }
+    xs_.resize(indexed_);
+    ys_.resize(indexed_);
+    for (std::size_t i = 0; i < indexed_; i++) {
+        xs_[i] = points_[order_[i]].x();
+        ys_[i] = points_[order_[i]].y();
+    }
+}
+
+std::uint32_t PointIndex2D::build(std::uint32_t begin, std::uint32_t end) {
+    Node node{points_[order_[begin]].x(), points_[order_[begin]].y(),
+              points_[order_[begin]].x(), points_[order_[begin]].y(),
+              begin, end, 0, 0};
+    for (auto i = begin + 1; i < end; i++) {
+        const auto &p = points_[order_[i]];
+        node.min_x = std::min(node.min_x, p.x());
+        node.min_y = std::min(node.min_y, p.y());
+        node.max_x = std::max(node.max_x, p.x());
+        node.max_y = std::max(node.max_y, p.y());
+    }
+    auto id = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back(node);
+    if (end - begin <= leaf_size)
+        return id;
+
+    // split the longer side at the median
+    bool split_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+    auto mid = begin + (end - begin) / 2;
+    std::nth_element(order_.begin() + begin, order_.begin() + mid, order_.begin() + end,
+                     [&](std::uint32_t a, std::uint32_t b) {
+        return split_x ? points_[a].x() < points_[b].x() : points_[a].y() < points_[b].y();
+    });
+    auto left = build(begin, mid);
+    auto right = build(mid, end);
+    nodes_[id].left = left;
+    nodes_[id].right = right;
+    return id;
+}
+
+std::size_t PointIndex2D::insert(const Point_2 &point) {
+    points_.push_back(point);
+    // rebuild once the linear scan costs about as much as the tree
+    if (points_.size() - indexed_ > std::max<std::size_t>(4 * leaf_size, indexed_ / 4))
+        rebuild();
+    return points_.size() - 1;
+}
+
+void PointIndex2D::reserve(std::size_t n) {
+    points_.reserve(n);
+}
+
+void PointIndex2D::clear() {
+    points_.clear();
+    nodes_.clear();
+    order_.clear();
+    xs_.clear();
+    ys_.clear();
+    indexed_ = 0;
+}
+
+std::vector<Point_2> PointIndex2D::query_closest(const Point_2 &query, std::size_t n) const {
+    n = std::min(n, points_.size());
+    std::vector<std::size_t> indices(n);
+    std::vector<double> sq_distances(n);
+    auto found = query_closest(query, indices, sq_distances);
+    std::vector<Point_2> results;
+    results.reserve(found);
+    for (std::size_t i = 0; i < found; i++)
+        results.push_back(points_[indices[i]]);
+    return results;
+}
+
+std::size_t PointIndex2D::query_closest(const Point_2 &query,
+                                        std::span<std::size_t> indices,
+                                        std::span<double> sq_distances) const {
+    assert(sq_distances.size() >= indices.size());
+    const std::size_t k = indices.size();
+    if (k == 0)
+        return 0;
+
+    // keep the k best sorted by insertion, k is small in practice
+    std::size_t found = 0;
+    auto offer = [&](std::size_t index, double d) {
+        if (found == k) {
+            if (d >= sq_distances[k - 1])
+                return;
+            found--;
+        }
+        std::size_t i = found++;
+        for (; i > 0 && sq_distances[i - 1] > d; i--) {
+            sq_distances[i] = sq_distances[i - 1];
+            indices[i] = indices[i - 1];
+        }
+        sq_distances[i] = d;
+        indices[i] = index;
+    };
+
+    const double qx = query.x(), qy = query.y();
+    if (!nodes_.empty()) {
+        std::uint32_t stack[64];
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+            if (found == k && box_sq_distance(node, qx, qy) >= sq_distances[k - 1])
+                continue;
+            if (node.left == 0) {
+                for (auto i = node.begin; i < node.end; i++) {
+                    double dx = xs_[i] - qx, dy = ys_[i] - qy;
+                    offer(order_[i], dx * dx + dy * dy);
+                }
+                continue;
+            }
+            // push the far child first so the near one is searched first
+            if (box_sq_distance(nodes_[node.left], qx, qy) <= box_sq_distance(nodes_[node.right], qx, qy)) {
+                stack[top++] = node.right;
+                stack[top++] = node.left;
+            } else {
+                stack[top++] = node.left;
+                stack[top++] = node.right;
+            }
+        }
+    }
+    for (auto i = indexed_; i < points_.size(); i++) {
+        double dx = points_[i].x() - qx, dy = points_[i].y() - qy;
+        offer(i, dx * dx + dy * dy);
+    }
+    return found;
+}
+
+std::size_t PointIndex2D::query_range(rect r, std::vector<std::size_t> &out) const {
+    return query_region(BoxRegion<rect>(r), out);
+}
+
+std::size_t PointIndex2D::query_range(bounds b, std::vector<std::size_t> &out) const {
+    return query_region(BoxRegion<bounds>(b), out);
+}
+
+std::size_t PointIndex2D::query_radius(const Point_2 &center, double radius, std::vector<std::size_t> &out) const {
+    return query_region(RadiusRegion{center.x(), center.y(), radius * radius}, out);
+}
+
+template <typename Region>
+std::size_t PointIndex2D::query_region(const Region &region, std::vector<std::size_t> &out) const {
+    const auto start = out.size();
+    if (!nodes_.empty()) {
+        std::uint8_t mask[leaf_size];
+        std::uint32_t stack[64];
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+            if (region.disjoint(node))
+                continue;
+            if (region.covers(node)) {
+                out.insert(out.end(), order_.begin() + node.begin, order_.begin() + node.end);
+                continue;
+            }
+            if (node.left != 0) {
+                stack[top++] = node.right;
+                stack[top++] = node.left;
+                continue;
+            }
+            auto count = node.end - node.begin;
+            auto hits = region.scan(std::span(xs_).subspan(node.begin, count),
+                                    std::span(ys_).subspan(node.begin, count),
+                                    std::span(mask, count));
+            for (std::uint32_t i = 0; hits > 0; i++) {
+                if (mask[i]) {
+                    out.push_back(order_[node.begin + i]);
+                    hits--;
+                }
+            }
+        }
+    }
+    for (auto i = indexed_; i < points_.size(); i++) {
+        if (region.contains(points_[i]))
+            out.push_back(i);
+    }
+    return out.size() - start;
+}
+
+std::vector<Point_2> query_closest(const PointIndex2D &index, const Point_2 &query, std::size_t n) {
+    return index.query_closest(query, n);
+}
+
+void query_closest(const PointIndex2D &index,
+                   std::span<const Point_2> queries,
+                   std::size_t k,
+                   std::span<std::size_t> indices,
+                   std::span<double> sq_distances,
+                   parallel::ThreadPool &pool) {
+    assert(indices.size() >= queries.size() * k);
+    assert(sq_distances.size() >= queries.size() * k);
+    if (k == 0)
+        return;
+    pool.parallel_for(queries.size(), 256, [&](std::size_t begin, std::size_t end) {
+        for (auto q = begin; q < end; q++) {
+            auto row_indices = indices.subspan(q * k, k);
+            auto row_distances = sq_distances.subspan(q * k, k);
+            auto found = index.query_closest(queries[q], row_indices, row_distances);
+            std::fill(row_indices.begin() + found, row_indices.end(), PointIndex2D::npos);
+            std::fill(row_distances.begin() + found, row_distances.end(), std::numeric_limits<double>::infinity());
+        }
+    });
+}
+
+graph::csr_graph build_knn_graph(std::span<const Point_2> points, std::size_t k, parallel::ThreadPool &pool) {
+    return build_knn_graph(PointIndex2D(std::vector<Point_2>(points.begin(), points.end())), k, pool);
+}
+
+graph::csr_graph build_knn_graph(const PointIndex2D &index, std::size_t k, parallel::ThreadPool &pool) {
+    assert(index.size() < std::numeric_limits<std::uint32_t>::max());
+    const std::size_t n = index.size();
+    k = std::min(k, n > 0 ? n - 1 : 0);
+    graph::csr_graph graph;
+    graph.offsets.resize(n + 1);
+    for (std::size_t i = 0; i <= n; i++)
+        graph.offsets[i] = i * k;
+    graph.neighbors.resize(n * k);
+    graph.weights.resize(n * k);
+    if (k == 0)
+        return graph;
+    pool.parallel_for(n, 256, [&](std::size_t begin, std::size_t end) {
+        // one extra neighbour since every point finds itself
+        std::vector<std::size_t> indices(k + 1);
+        std::vector<double> sq_distances(k + 1);
+        for (auto i = begin; i < end; i++) {
+            index.query_closest(index[i], indices, sq_distances);
+            // coincident points can be listed ahead of i, so look for it rather than dropping the first
+            auto self = static_cast<std::size_t>(std::find(indices.begin(), indices.end(), i) - indices.begin());
+            self = std::min(self, k);
+            for (std::size_t j = 0, out = i * k; j <= k; j++) {
+                if (j == self)
+                    continue;
+                graph.neighbors[out] = static_cast<std::uint32_t>(indices[j]);
+                graph.weights[out++] = static_cast<float>(std::sqrt(sq_distances[j]));
+            }
+        }
+    });
+    return graph;
+}
+
+} // namespace utils::math
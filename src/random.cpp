@@ -0,0 +1,204 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <type_traits>
+#include <utils/random.h>
+
+
+namespace utils::random {
+
+namespace {
+
+constexpr std::size_t lanes = 32;
+
+// spans shorter than this are cheaper to fill from the scalar generator
+constexpr std::size_t min_interleaved_fill = 4 * lanes;
+
+std::uint64_t process_seed() {
+    static const std::uint64_t seed = [] {
+        std::random_device rd;
+        return std::uint64_t{rd()} << 32 | rd();
+    }();
+    return seed;
+}
+
+std::atomic<std::uint64_t> next_stream{0};
+
+constexpr std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// fills out in blocks of PerBlock values, convert(bits, block) turning lanes random words into one block
+template <std::size_t PerBlock, typename T, typename Convert>
+void fill_blocks(std::span<T> out, Xoshiro256 &rng, Convert &&convert) {
+    std::uint64_t bits[lanes];
+    T block[PerBlock];
+    std::size_t i = 0;
+    if (out.size() < min_interleaved_fill) {
+        while (i < out.size()) {
+            for (auto &b: bits)
+                b = rng();
+            convert(bits, block);
+            for (std::size_t j = 0; j < PerBlock && i < out.size(); j++)
+                out[i++] = block[j];
+        }
+        return;
+    }
+
+    // lanes independent xoshiro256** streams seeded from rng, one state word per array so that
+    // each step below is a handful of vector operations
+    std::uint64_t s0[lanes], s1[lanes], s2[lanes], s3[lanes];
+    for (std::size_t l = 0; l < lanes; l++) {
+        s0[l] = rng();
+        s1[l] = rng();
+        s2[l] = rng();
+        // an all zero state would never leave zero
+        s3[l] = rng() | 1;
+    }
+    auto next = [&] {
+        for (std::size_t l = 0; l < lanes; l++) {
+            bits[l] = rotl(s1[l] * 5, 7) * 9;
+            const auto t = s1[l] << 17;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = rotl(s3[l], 45);
+        }
+    };
+    for (; i + PerBlock <= out.size(); i += PerBlock) {
+        next();
+        convert(bits, out.data() + i);
+    }
+    if (i < out.size()) {
+        next();
+        convert(bits, block);
+        for (std::size_t j = 0; i < out.size(); j++)
+            out[i++] = block[j];
+    }
+}
+
+// uniform in [0, 1) from the high bits of a random word, through conversions that have vector
+// forms on every x86-64 level (a 64-bit integer to floating point conversion needs AVX-512)
+template <typename T>
+T unit_interval(std::uint64_t bits) {
+    if constexpr (std::is_same_v<T, float>)
+        return static_cast<float>(static_cast<std::int32_t>(bits >> 40)) * 0x1.0p-24f;
+    else
+        return std::bit_cast<double>(0x3ff0000000000000ULL | bits >> 12) - 1.0;
+}
+
+template <typename T>
+void fill_uniform_impl(std::span<T> out, T a, T b, Xoshiro256 &rng) {
+    const T scale = b - a;
+    fill_blocks<lanes>(out, rng, [=](const std::uint64_t *bits, T *block) {
+        for (std::size_t l = 0; l < lanes; l++)
+            block[l] = a + scale * unit_interval<T>(bits[l]);
+    });
+}
+
+template <typename T>
+void fill_normal_impl(std::span<T> out, T mean, T stddev, Xoshiro256 &rng) {
+    constexpr T two_pi = 2 * std::numbers::pi_v<T>;
+    fill_blocks<lanes>(out, rng, [=](const std::uint64_t *bits, T *block) {
+        for (std::size_t l = 0; l < lanes; l += 2) {
+            // 1 - u is in (0, 1] so the logarithm stays finite
+            const T radius = stddev * std::sqrt(T(-2) * std::log(T(1) - unit_interval<T>(bits[l])));
+            const T angle = two_pi * unit_interval<T>(bits[l + 1]);
+            block[l] = mean + radius * std::cos(angle);
+            block[l + 1] = mean + radius * std::sin(angle);
+        }
+    });
+}
+
+} // namespace
+
+Xoshiro256 &thread_generator() {
+    thread_local Xoshiro256 generator(process_seed() + 0x9e3779b97f4a7c15ULL * next_stream.fetch_add(1));
+    return generator;
+}
+
+void seed_thread_generator(std::uint64_t seed) {
+    thread_generator().seed(seed);
+}
+
+void fill_bits(std::span<std::uint64_t> out, Xoshiro256 &rng) {
+    fill_blocks<lanes>(out, rng, [](const std::uint64_t *bits, std::uint64_t *block) {
+        std::copy_n(bits, lanes, block);
+    });
+}
+
+void fill_uniform(std::span<float> out, float a, float b, Xoshiro256 &rng) {
+    fill_uniform_impl(out, a, b, rng);
+}
+
+void fill_uniform(std::span<double> out, double a, double b, Xoshiro256 &rng) {
+    fill_uniform_impl(out, a, b, rng);
+}
+
+void fill_normal(std::span<float> out, float mean, float stddev, Xoshiro256 &rng) {
+    fill_normal_impl(out, mean, stddev, rng);
+}
+
+void fill_normal(std::span<double> out, double mean, double stddev, Xoshiro256 &rng) {
+    fill_normal_impl(out, mean, stddev, rng);
+}
+
+void fill_uniform_int(std::span<std::int32_t> out, std::int32_t lo, std::int32_t hi, Xoshiro256 &rng) {
+    assert(lo <= hi);
+    // Lemire's multiply and shift on each 32-bit half of a word; the few draws that would be
+    // biased are redone from the scalar generator after the block
+    const std::uint64_t range = static_cast<std::uint64_t>(std::int64_t{hi} - lo) + 1;
+    const auto threshold = static_cast<std::uint32_t>(((std::uint64_t{1} << 32) - range) % range);
+    fill_blocks<2 * lanes>(out, rng, [&](const std::uint64_t *bits, std::int32_t *block) {
+        // the low halves of the words fill the first half of the block, the high halves the second
+        std::uint64_t products[2 * lanes];
+        for (std::size_t l = 0; l < lanes; l++) {
+            products[l] = (bits[l] & 0xffffffffu) * range;
+            products[lanes + l] = (bits[l] >> 32) * range;
+        }
+        // unsigned so that offsets past INT32_MAX wrap instead of overflowing
+        const auto base = static_cast<std::uint32_t>(lo);
+        std::uint32_t biased = 0;
+        for (std::size_t j = 0; j < 2 * lanes; j++) {
+            block[j] = static_cast<std::int32_t>(base + static_cast<std::uint32_t>(products[j] >> 32));
+            biased |= static_cast<std::uint32_t>(products[j]) < threshold;
+        }
+        if (!biased)
+            return;
+        for (std::size_t j = 0; j < 2 * lanes; j++)
+            if (static_cast<std::uint32_t>(products[j]) < threshold)
+                block[j] = static_cast<std::int32_t>(base + static_cast<std::uint32_t>(rng.next_below(range)));
+    });
+}
+
+} // namespace utils::random
@@ -0,0 +1,124 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fmt/format.h>
+#include <mutex>
+#include <stdexcept>
+#include <utils/schema_registry.h>
+
+
+using std::runtime_error;
+
+namespace utils::file {
+
+namespace {
+
+// collects every error instead of throwing on the first like the default handler
+class CollectingErrorHandler : public nlohmann::json_schema::error_handler {
+public:
+    explicit CollectingErrorHandler(validation_result &result) : result_(result) {}
+
+    void error(const json::json_pointer &ptr, const json &, const std::string &message) override {
+        result_.errors.push_back({ptr.to_string(), message});
+    }
+
+private:
+    validation_result &result_;
+};
+
+const std::string *schema_id(const json &schema) {
+    if (!schema.is_object())
+        return nullptr;
+    auto it = schema.find("$id");
+    return it != schema.end() && it->is_string() ? it->get_ptr<const std::string *>() : nullptr;
+}
+
+} // namespace
+
+SchemaRegistry &SchemaRegistry::global() {
+    static SchemaRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<const SchemaRegistry::Validator> SchemaRegistry::compile(const json &schema) {
+    const auto *id = schema_id(schema);
+    {
+        std::shared_lock lock(mutex_);
+        if (id) {
+            if (auto it = by_id_.find(*id); it != by_id_.end())
+                return it->second;
+        } else if (auto it = by_content_.find(schema); it != by_content_.end()) {
+            return it->second;
+        }
+    }
+
+    // compile outside the lock; if another thread got there first its validator is kept
+    auto validator = std::make_shared<Validator>();
+    try {
+        validator->set_root_schema(schema);
+    } catch (const std::exception &e) {
+        throw runtime_error(fmt::format("Schema error: {0}", e.what()));
+    }
+    std::unique_lock lock(mutex_);
+    if (id)
+        return by_id_.try_emplace(*id, std::move(validator)).first->second;
+    return by_content_.try_emplace(schema, std::move(validator)).first->second;
+}
+
+std::shared_ptr<const SchemaRegistry::Validator> SchemaRegistry::find(const std::string &id) const {
+    std::shared_lock lock(mutex_);
+    auto it = by_id_.find(id);
+    return it != by_id_.end() ? it->second : nullptr;
+}
+
+validation_result SchemaRegistry::validate(const json &data, const json &schema) {
+    return validate(data, *compile(schema));
+}
+
+validation_result SchemaRegistry::validate_id(const json &data, const std::string &id) const {
+    auto validator = find(id);
+    if (!validator)
+        throw runtime_error(fmt::format("No schema registered with $id {0}", id));
+    return validate(data, *validator);
+}
+
+validation_result SchemaRegistry::validate(const json &data, const Validator &validator) {
+    validation_result result;
+    CollectingErrorHandler handler(result);
+    validator.validate(data, handler);
+    return result;
+}
+
+std::size_t SchemaRegistry::size() const {
+    std::shared_lock lock(mutex_);
+    return by_id_.size() + by_content_.size();
+}
+
+void SchemaRegistry::clear() {
+    std::unique_lock lock(mutex_);
+    by_id_.clear();
+    by_content_.clear();
+}
+
+} // namespace utils::file
@@ -0,0 +1,319 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <utils/flat_hash.h>
+#include <utils/math_util.h>
+#include <utils/segment_intersection.h>
+
+
+namespace utils::math {
+
+namespace {
+
+bool lex_less(glm::dvec2 a, glm::dvec2 b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+struct LexLess {
+    bool operator()(glm::dvec2 a, glm::dvec2 b) const {
+        return lex_less(a, b);
+    }
+};
+
+std::uint64_t pair_key(std::size_t a, std::size_t b) {
+    if (a > b)
+        std::swap(a, b);
+    return (static_cast<std::uint64_t>(a) << 32) | b;
+}
+
+// segments starting, ending and crossing at an event point
+struct Event {
+    std::vector<std::size_t> upper;
+    std::vector<std::size_t> lower;
+    std::vector<std::size_t> crossing;
+};
+
+class BentleyOttmann {
+public:
+    explicit BentleyOttmann(std::span<const line_segment> segments)
+            : status_(Order{this}), where_(segments.size()), active_(segments.size(), 0) {
+        assert(segments.size() < (std::size_t{1} << 32));
+        left_.reserve(segments.size());
+        right_.reserve(segments.size());
+        slack_.reserve(segments.size());
+
+        double scale = 1;
+        for (const auto &s : segments)
+            scale = std::max({scale, std::abs(s.start.x), std::abs(s.start.y),
+                              std::abs(s.end.x), std::abs(s.end.y)});
+        // y is compared at computed crossing points, so segments meeting there only
+        // agree up to rounding; the slack covers that and grows with the slope
+        probe_slack_ = 256 * std::numeric_limits<double>::epsilon() * scale;
+
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            auto a = segments[i].start, b = segments[i].end;
+            if (lex_less(b, a))
+                std::swap(a, b);
+            left_.push_back(a);
+            right_.push_back(b);
+            double slope = a.x == b.x ? 0 : std::abs((b.y - a.y) / (b.x - a.x));
+            slack_.push_back(probe_slack_ * (1 + std::min(slope, 1e6)));
+            events_[a].upper.push_back(i);
+            events_[b].lower.push_back(i);
+        }
+    }
+
+    std::vector<segment_intersection> run() {
+        while (!events_.empty()) {
+            auto node = events_.extract(events_.begin());
+            handle(node.key(), node.mapped());
+        }
+        return std::move(result_);
+    }
+
+private:
+    // stands in for the event point itself when searching the status
+    static constexpr std::size_t probe = std::numeric_limits<std::size_t>::max();
+
+    struct Order {
+        const BentleyOttmann *sweep;
+
+        bool operator()(std::size_t a, std::size_t b) const {
+            return sweep->below(a, b);
+        }
+    };
+
+    using Status = std::set<std::size_t, Order>;
+
+    bool vertical(std::size_t i) const {
+        return left_[i].x == right_[i].x;
+    }
+
+    double slack(std::size_t i) const {
+        return i == probe ? probe_slack_ : slack_[i];
+    }
+
+    // height of a segment on the sweep line; vertical segments sit at the event point
+    double y_at(std::size_t i) const {
+        if (i == probe)
+            return sweep_.y;
+        auto a = left_[i], b = right_[i];
+        if (a.x == b.x)
+            return std::clamp(sweep_.y, a.y, b.y);
+        if (sweep_.x <= a.x)
+            return a.y;
+        if (sweep_.x >= b.x)
+            return b.y;
+        return a.y + (sweep_.x - a.x) / (b.x - a.x) * (b.y - a.y);
+    }
+
+    // status order on the sweep line; segments meeting at the event point are ordered
+    // as they leave it, by exact slope, with vertical segments on top
+    bool below(std::size_t i, std::size_t j) const {
+        if (i == j)
+            return false;
+        double yi = y_at(i), yj = y_at(j);
+        double tolerance = slack(i) + slack(j);
+        if (yi < yj - tolerance)
+            return true;
+        if (yj < yi - tolerance)
+            return false;
+        if (i == probe || j == probe)
+            return i == probe;
+        bool vi = vertical(i), vj = vertical(j);
+        if (vi || vj)
+            return vi && vj ? i < j : vj;
+        double c = cross2d(left_[i], right_[i], left_[j], right_[j]);
+        if (c != 0)
+            return c > 0;
+        return i < j;
+    }
+
+    bool contains(std::size_t i, glm::dvec2 p) const {
+        return orient2d(left_[i], right_[i], p) == 0 && !lex_less(p, left_[i]) && !lex_less(right_[i], p);
+    }
+
+    bool intersect(std::size_t i, std::size_t j) const {
+        auto a = left_[i], b = right_[i], c = left_[j], d = right_[j];
+        double o1 = orient2d(a, b, c), o2 = orient2d(a, b, d);
+        double o3 = orient2d(c, d, a), o4 = orient2d(c, d, b);
+        if (((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) && ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0)))
+            return true;
+        return (o1 == 0 && contains(i, c)) || (o2 == 0 && contains(i, d)) ||
+               (o3 == 0 && contains(j, a)) || (o4 == 0 && contains(j, b));
+    }
+
+    // leftmost common point of two intersecting segments; endpoints touching the other
+    // segment are returned exactly so they coincide with their endpoint events
+    glm::dvec2 intersection_point(std::size_t i, std::size_t j) const {
+        auto lo = std::max(left_[i], left_[j], LexLess{});
+        auto hi = std::min(right_[i], right_[j], LexLess{});
+        if (cross2d(left_[i], right_[i], left_[j], right_[j]) == 0)
+            return lo;
+        for (auto [s, p] : {std::pair{i, left_[j]}, {i, right_[j]}, {j, left_[i]}, {j, right_[i]}})
+            if (contains(s, p))
+                return p;
+
+        auto r = right_[i] - left_[i], s = right_[j] - left_[j], q = left_[j] - left_[i];
+        double t = (q.x * s.y - q.y * s.x) / (r.x * s.y - r.y * s.x);
+        auto p = left_[i] + std::clamp(t, 0.0, 1.0) * r;
+        if (lex_less(p, lo))
+            return lo;
+        if (lex_less(hi, p))
+            return hi;
+        return p;
+    }
+
+    void report(std::size_t i, std::size_t j, glm::dvec2 p) {
+        if (reported_.insert(pair_key(i, j)))
+            result_.push_back({std::min(i, j), std::max(i, j), p});
+    }
+
+    // schedule the crossing of two status neighbours ahead of the sweep
+    void check(std::size_t i, std::size_t j) {
+        if (scheduled_.contains(pair_key(i, j)) || !intersect(i, j))
+            return;
+        scheduled_.insert(pair_key(i, j));
+        auto p = intersection_point(i, j);
+        if (lex_less(sweep_, p)) {
+            auto &event = events_[p];
+            event.crossing.push_back(i);
+            event.crossing.push_back(j);
+        } else {
+            // rounded onto or behind the sweep line
+            report(i, j, p);
+        }
+    }
+
+    void handle(glm::dvec2 p, Event &event) {
+        sweep_ = p;
+
+        // active segments passing exactly through p that no neighbour test scheduled,
+        // e.g. a T-junction at another segment's endpoint; the rest of the band that
+        // ties with p is only near it, as with three segments meeting at a rounded point
+        near_.clear();
+        for (auto it = status_.lower_bound(probe); it != status_.end(); ++it) {
+            if (y_at(*it) > p.y + slack(*it) + probe_slack_)
+                break;
+            if (contains(*it, p))
+                event.crossing.push_back(*it);
+            else
+                near_.push_back(*it);
+        }
+
+        auto &through = event.upper;
+        through.insert(through.end(), event.lower.begin(), event.lower.end());
+        through.insert(through.end(), event.crossing.begin(), event.crossing.end());
+        std::sort(through.begin(), through.end());
+        through.erase(std::unique(through.begin(), through.end()), through.end());
+        std::erase_if(near_, [&](std::size_t s) {
+            return std::binary_search(through.begin(), through.end(), s);
+        });
+        for (std::size_t a = 0; a < through.size(); ++a)
+            for (std::size_t b = a + 1; b < through.size(); ++b)
+                if (!reported_.contains(pair_key(through[a], through[b])) && intersect(through[a], through[b]))
+                    report(through[a], through[b], p);
+        // the band may reverse as a whole, so its pairs never become neighbours
+        for (std::size_t a = 0; a < near_.size(); ++a) {
+            for (std::size_t b = a + 1; b < near_.size(); ++b)
+                check(near_[a], near_[b]);
+            for (auto s : through)
+                check(near_[a], s);
+        }
+        through.insert(through.end(), near_.begin(), near_.end());
+
+        // everything through p leaves the status and whatever continues past p is
+        // reinserted in its order to the right of p
+        inserted_.clear();
+        for (auto s : through) {
+            bool continues = lex_less(p, right_[s]);
+            if (active_[s]) {
+                status_.erase(where_[s]);
+                active_[s] = 0;
+            } else if (left_[s] != p) {
+                // already ended or not yet started
+                continues = false;
+            }
+            if (continues)
+                inserted_.push_back(s);
+        }
+        for (auto s : inserted_) {
+            where_[s] = status_.insert(s).first;
+            active_[s] = 1;
+        }
+
+        if (inserted_.empty()) {
+            auto above = status_.lower_bound(probe);
+            if (above != status_.end() && above != status_.begin())
+                check(*std::prev(above), *above);
+            return;
+        }
+
+        auto lowest = where_[inserted_.front()], highest = lowest;
+        for (auto s : inserted_) {
+            if (below(s, *lowest))
+                lowest = where_[s];
+            if (below(*highest, s))
+                highest = where_[s];
+        }
+        if (lowest != status_.begin())
+            check(*std::prev(lowest), *lowest);
+        for (auto it = lowest; it != highest && std::next(it) != status_.end(); ++it)
+            check(*it, *std::next(it));
+        if (std::next(highest) != status_.end())
+            check(*highest, *std::next(highest));
+    }
+
+    std::vector<glm::dvec2> left_;
+    std::vector<glm::dvec2> right_;
+    std::vector<double> slack_;
+    double probe_slack_{0};
+    glm::dvec2 sweep_{-std::numeric_limits<double>::infinity()};
+
+    std::map<glm::dvec2, Event, LexLess> events_;
+    Status status_;
+    std::vector<Status::iterator> where_;
+    std::vector<char> active_;
+    std::vector<std::size_t> near_;
+    std::vector<std::size_t> inserted_;
+
+    // pairs already tested as neighbours and pairs already in the result
+    FlatHashSet<std::uint64_t, MixHash> scheduled_;
+    FlatHashSet<std::uint64_t, MixHash> reported_;
+    std::vector<segment_intersection> result_;
+};
+
+} // namespace
+
+std::vector<segment_intersection> find_segment_intersections(std::span<const line_segment> segments) {
+    return BentleyOttmann(segments).run();
+}
+
+} // namespace utils::math
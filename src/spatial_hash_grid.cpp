@@ -0,0 +1,469 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utils/spatial_hash_grid.h>
+
+
+namespace utils::math {
+
+namespace {
+
+// compaction only pays off once the gaps outweigh the live entries
+constexpr std::size_t min_holes_to_compact = 1024;
+
+constexpr std::size_t rebuild_grain = 4096;
+
+double x_of(const Point_2 &p) {
+    return p.x();
+}
+
+double y_of(const Point_2 &p) {
+    return p.y();
+}
+
+double x_of(glm::vec2 p) {
+    return p.x;
+}
+
+double y_of(glm::vec2 p) {
+    return p.y;
+}
+
+std::uint64_t pack(std::int64_t cx, std::int64_t cy) {
+    return std::uint64_t{static_cast<std::uint32_t>(cx)} << 32 | static_cast<std::uint32_t>(cy);
+}
+
+std::int32_t unpack_x(std::uint64_t key) {
+    return static_cast<std::int32_t>(key >> 32);
+}
+
+std::int32_t unpack_y(std::uint64_t key) {
+    return static_cast<std::int32_t>(key & 0xffffffffu);
+}
+
+} // namespace
+
+SpatialHashGrid2D::SpatialHashGrid2D(double cell_size)
+        : cell_size_(cell_size), inv_cell_size_(1.0 / cell_size) {
+    assert(cell_size > 0);
+    reset_extent();
+}
+
+void SpatialHashGrid2D::rebuild(std::span<const Point_2> points, parallel::ThreadPool &pool) {
+    rebuild_points(points, pool);
+}
+
+void SpatialHashGrid2D::rebuild(std::span<const glm::vec2> points, parallel::ThreadPool &pool) {
+    rebuild_points(points, pool);
+}
+
+template <typename Point>
+void SpatialHashGrid2D::rebuild_points(std::span<const Point> points, parallel::ThreadPool &pool) {
+    assert(points.size() < no_cell);
+    const auto n = static_cast<std::uint32_t>(points.size());
+    clear();
+    std::vector<std::uint64_t> keys(n);
+    pool.parallel_for(n, rebuild_grain, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            keys[i] = cell_key(x_of(points[i]), y_of(points[i]));
+    });
+
+    // counting sort by cell, the hash lookups are the only serial pass
+    cell_of_.resize(n);
+    slots_.resize(n);
+    for (std::uint32_t i = 0; i < n; i++) {
+        auto cell = find_or_add_cell(keys[i]);
+        cell_of_[i] = cell;
+        cells_[cell].size++;
+    }
+    std::uint32_t offset = 0;
+    for (auto &cell: cells_) {
+        cell.begin = offset;
+        cell.capacity = cell.size;
+        offset += cell.size;
+        cell.size = 0;
+    }
+    ids_.resize(n);
+    for (std::uint32_t i = 0; i < n; i++) {
+        auto &cell = cells_[cell_of_[i]];
+        slots_[i] = cell.begin + cell.size++;
+        ids_[slots_[i]] = i;
+    }
+    xs_.resize(n);
+    ys_.resize(n);
+    pool.parallel_for(n, rebuild_grain, [&](std::size_t begin, std::size_t end) {
+        for (auto s = begin; s < end; s++) {
+            xs_[s] = x_of(points[ids_[s]]);
+            ys_[s] = y_of(points[ids_[s]]);
+        }
+    });
+    size_ = n;
+}
+
+std::size_t SpatialHashGrid2D::insert(const Point_2 &point) {
+    auto id = new_id();
+    place(static_cast<std::uint32_t>(id), point.x(), point.y());
+    return id;
+}
+
+std::size_t SpatialHashGrid2D::insert(glm::vec2 point) {
+    auto id = new_id();
+    place(static_cast<std::uint32_t>(id), point.x, point.y);
+    return id;
+}
+
+void SpatialHashGrid2D::remove(std::size_t id) {
+    assert(contains(id));
+    unlink(static_cast<std::uint32_t>(id));
+    free_ids_.push_back(static_cast<std::uint32_t>(id));
+    size_--;
+}
+
+void SpatialHashGrid2D::move(std::size_t id, const Point_2 &point) {
+    assert(contains(id));
+    move_to(static_cast<std::uint32_t>(id), point.x(), point.y());
+}
+
+void SpatialHashGrid2D::move(std::size_t id, glm::vec2 point) {
+    assert(contains(id));
+    move_to(static_cast<std::uint32_t>(id), point.x, point.y);
+}
+
+void SpatialHashGrid2D::clear() {
+    cells_.clear();
+    cell_index_.clear();
+    ids_.clear();
+    xs_.clear();
+    ys_.clear();
+    cell_of_.clear();
+    slots_.clear();
+    free_ids_.clear();
+    size_ = 0;
+    holes_ = 0;
+    reset_extent();
+}
+
+void SpatialHashGrid2D::compact() {
+    std::vector<Cell> cells;
+    std::vector<std::uint32_t> ids(size_);
+    std::vector<double> xs(size_), ys(size_);
+    cell_index_.clear();
+    reset_extent();
+    std::uint32_t offset = 0;
+    for (const auto &cell: cells_) {
+        if (cell.size == 0)
+            continue;
+        auto index = static_cast<std::uint32_t>(cells.size());
+        cells.push_back({cell.key, offset, cell.size, cell.size});
+        cell_index_[cell.key] = index;
+        min_cx_ = std::min(min_cx_, unpack_x(cell.key));
+        max_cx_ = std::max(max_cx_, unpack_x(cell.key));
+        min_cy_ = std::min(min_cy_, unpack_y(cell.key));
+        max_cy_ = std::max(max_cy_, unpack_y(cell.key));
+        for (std::uint32_t i = 0; i < cell.size; i++) {
+            auto id = ids_[cell.begin + i];
+            ids[offset] = id;
+            xs[offset] = xs_[cell.begin + i];
+            ys[offset] = ys_[cell.begin + i];
+            cell_of_[id] = index;
+            slots_[id] = offset++;
+        }
+    }
+    cells_ = std::move(cells);
+    ids_ = std::move(ids);
+    xs_ = std::move(xs);
+    ys_ = std::move(ys);
+    holes_ = 0;
+}
+
+std::int32_t SpatialHashGrid2D::cell_coord(double v) const {
+    assert(!std::isnan(v));
+    return static_cast<std::int32_t>(std::clamp(std::floor(v * inv_cell_size_),
+                                                double(std::numeric_limits<std::int32_t>::min()),
+                                                double(std::numeric_limits<std::int32_t>::max())));
+}
+
+std::uint64_t SpatialHashGrid2D::cell_key(double x, double y) const {
+    return pack(cell_coord(x), cell_coord(y));
+}
+
+std::uint32_t SpatialHashGrid2D::find_or_add_cell(std::uint64_t key) {
+    auto [index, added] = cell_index_.try_emplace(key, static_cast<std::uint32_t>(cells_.size()));
+    if (added) {
+        cells_.push_back({key, static_cast<std::uint32_t>(ids_.size()), 0, 0});
+        min_cx_ = std::min(min_cx_, unpack_x(key));
+        max_cx_ = std::max(max_cx_, unpack_x(key));
+        min_cy_ = std::min(min_cy_, unpack_y(key));
+        max_cy_ = std::max(max_cy_, unpack_y(key));
+    }
+    return *index;
+}
+
+void SpatialHashGrid2D::grow(std::uint32_t index) {
+    auto &cell = cells_[index];
+    const auto capacity = std::max<std::uint32_t>(4, 2 * cell.capacity);
+    assert(ids_.size() + capacity < no_cell);
+    // the last run can grow in place, any other moves to the end
+    if (cell.begin + cell.capacity != ids_.size()) {
+        const auto begin = static_cast<std::uint32_t>(ids_.size());
+        ids_.resize(begin + cell.size);
+        xs_.resize(begin + cell.size);
+        ys_.resize(begin + cell.size);
+        for (std::uint32_t i = 0; i < cell.size; i++) {
+            ids_[begin + i] = ids_[cell.begin + i];
+            xs_[begin + i] = xs_[cell.begin + i];
+            ys_[begin + i] = ys_[cell.begin + i];
+            slots_[ids_[begin + i]] = begin + i;
+        }
+        holes_ += cell.capacity;
+        cell.begin = begin;
+    }
+    cell.capacity = capacity;
+    ids_.resize(cell.begin + capacity);
+    xs_.resize(cell.begin + capacity);
+    ys_.resize(cell.begin + capacity);
+}
+
+void SpatialHashGrid2D::place(std::uint32_t id, double x, double y) {
+    auto index = find_or_add_cell(cell_key(x, y));
+    if (cells_[index].size == cells_[index].capacity) {
+        if (holes_ > std::max(min_holes_to_compact, size_)) {
+            // compaction drops empty cells and renumbers the rest
+            const auto key = cells_[index].key;
+            compact();
+            index = find_or_add_cell(key);
+        }
+        if (cells_[index].size == cells_[index].capacity)
+            grow(index);
+    }
+    auto &cell = cells_[index];
+    const auto slot = cell.begin + cell.size++;
+    ids_[slot] = id;
+    xs_[slot] = x;
+    ys_[slot] = y;
+    cell_of_[id] = index;
+    slots_[id] = slot;
+}
+
+void SpatialHashGrid2D::unlink(std::uint32_t id) {
+    // fill the hole with the last entry of the cell
+    auto &cell = cells_[cell_of_[id]];
+    const auto slot = slots_[id];
+    const auto last = cell.begin + --cell.size;
+    ids_[slot] = ids_[last];
+    xs_[slot] = xs_[last];
+    ys_[slot] = ys_[last];
+    slots_[ids_[slot]] = slot;
+    cell_of_[id] = no_cell;
+    if (cell.size > 0)
+        return;
+    // an emptied cell gives up its run, so points wandering between cells leave gaps compact() reclaims
+    if (cell.begin + cell.capacity == ids_.size()) {
+        ids_.resize(cell.begin);
+        xs_.resize(cell.begin);
+        ys_.resize(cell.begin);
+    } else {
+        holes_ += cell.capacity;
+    }
+    cell.capacity = 0;
+}
+
+void SpatialHashGrid2D::move_to(std::uint32_t id, double x, double y) {
+    if (cells_[cell_of_[id]].key == cell_key(x, y)) {
+        xs_[slots_[id]] = x;
+        ys_[slots_[id]] = y;
+        return;
+    }
+    unlink(id);
+    place(id, x, y);
+}
+
+std::size_t SpatialHashGrid2D::new_id() {
+    size_++;
+    if (!free_ids_.empty()) {
+        auto id = free_ids_.back();
+        free_ids_.pop_back();
+        return id;
+    }
+    assert(cell_of_.size() < no_cell);
+    cell_of_.push_back(no_cell);
+    slots_.push_back(0);
+    return cell_of_.size() - 1;
+}
+
+void SpatialHashGrid2D::reset_extent() {
+    min_cx_ = min_cy_ = std::numeric_limits<std::int32_t>::max();
+    max_cx_ = max_cy_ = std::numeric_limits<std::int32_t>::min();
+}
+
+template <typename Visit>
+void SpatialHashGrid2D::for_each_cell(std::int64_t x0, std::int64_t y0, std::int64_t x1, std::int64_t y1,
+                                      Visit &&visit) const {
+    x0 = std::max<std::int64_t>(x0, min_cx_);
+    y0 = std::max<std::int64_t>(y0, min_cy_);
+    x1 = std::min<std::int64_t>(x1, max_cx_);
+    y1 = std::min<std::int64_t>(y1, max_cy_);
+    if (x0 > x1 || y0 > y1)
+        return;
+    // walking every cell is cheaper than probing a box that holds more cells than exist
+    if (static_cast<double>(x1 - x0 + 1) * static_cast<double>(y1 - y0 + 1) > static_cast<double>(cells_.size())) {
+        for (const auto &cell: cells_) {
+            auto cx = unpack_x(cell.key), cy = unpack_y(cell.key);
+            if (cell.size > 0 && cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1)
+                visit(cell);
+        }
+        return;
+    }
+    for (auto cx = x0; cx <= x1; cx++) {
+        for (auto cy = y0; cy <= y1; cy++) {
+            if (auto index = cell_index_.find(pack(cx, cy)))
+                visit(cells_[*index]);
+        }
+    }
+}
+
+template <typename Contains>
+std::size_t SpatialHashGrid2D::query_box(double x0, double y0, double x1, double y1, Contains &&contains,
+                                         std::vector<std::size_t> &out) const {
+    const auto start = out.size();
+    if (size_ == 0 || !(x0 <= x1) || !(y0 <= y1))
+        return 0;
+    for_each_cell(cell_coord(x0), cell_coord(y0), cell_coord(x1), cell_coord(y1), [&](const Cell &cell) {
+        for (auto s = cell.begin; s < cell.begin + cell.size; s++) {
+            if (contains(xs_[s], ys_[s]))
+                out.push_back(ids_[s]);
+        }
+    });
+    return out.size() - start;
+}
+
+std::size_t SpatialHashGrid2D::query_range(rect r, std::vector<std::size_t> &out) const {
+    return query_box(r.x, r.y, r.x + r.w, r.y + r.h, [r](double x, double y) {
+        return in_rect(x, y, r);
+    }, out);
+}
+
+std::size_t SpatialHashGrid2D::query_range(bounds b, std::vector<std::size_t> &out) const {
+    return query_box(b.top_left.x, b.top_left.y, b.bottom_right.x, b.bottom_right.y, [b](double x, double y) {
+        return in_bounds(x, y, b);
+    }, out);
+}
+
+std::size_t SpatialHashGrid2D::query_radius(const Point_2 &center, double radius, std::vector<std::size_t> &out) const {
+    const double cx = center.x(), cy = center.y(), sq_radius = radius * radius;
+    return query_box(cx - radius, cy - radius, cx + radius, cy + radius, [=](double x, double y) {
+        double dx = x - cx, dy = y - cy;
+        return dx * dx + dy * dy <= sq_radius;
+    }, out);
+}
+
+std::size_t SpatialHashGrid2D::query_closest(const Point_2 &query,
+                                             std::span<std::size_t> indices,
+                                             std::span<double> sq_distances) const {
+    assert(sq_distances.size() >= indices.size());
+    const std::size_t k = indices.size();
+    if (k == 0 || size_ == 0)
+        return 0;
+
+    // keep the k best sorted by insertion, k is small in practice
+    std::size_t found = 0;
+    auto offer = [&](std::size_t index, double d) {
+        if (found == k) {
+            if (d >= sq_distances[k - 1])
+                return;
+            found--;
+        }
+        std::size_t i = found++;
+        for (; i > 0 && sq_distances[i - 1] > d; i--) {
+            sq_distances[i] = sq_distances[i - 1];
+            indices[i] = indices[i - 1];
+        }
+        sq_distances[i] = d;
+        indices[i] = index;
+    };
+
+    const double qx = query.x(), qy = query.y();
+    auto scan = [&](const Cell &cell) {
+        for (auto s = cell.begin; s < cell.begin + cell.size; s++) {
+            double dx = xs_[s] - qx, dy = ys_[s] - qy;
+            offer(ids_[s], dx * dx + dy * dy);
+        }
+    };
+
+    // search square rings of cells outwards from the query's cell, starting at the first ring that
+    // reaches an occupied cell and stopping once no closer point can lie further out
+    const std::int64_t qcx = cell_coord(qx), qcy = cell_coord(qy);
+    const auto first = std::max({std::int64_t{0}, min_cx_ - qcx, qcx - max_cx_, min_cy_ - qcy, qcy - max_cy_});
+    const auto last = std::max({qcx - min_cx_, max_cx_ - qcx, qcy - min_cy_, max_cy_ - qcy});
+    std::size_t probes = 0;
+    for (auto r = first; r <= last; r++) {
+        // every point in ring r is more than (r - 1) cells away along one axis
+        const double gap = static_cast<double>(std::max<std::int64_t>(r - 1, 0)) * cell_size_;
+        if (found == k && gap * gap >= sq_distances[k - 1])
+            break;
+        probes += r == 0 ? 1 : 8 * r;
+        if (probes > 4 * cells_.size()) {
+            // the rings are mostly empty, finish with a scan of every cell
+            found = 0;
+            for (const auto &cell: cells_)
+                scan(cell);
+            break;
+        }
+        if (r == 0) {
+            for_each_cell(qcx, qcy, qcx, qcy, scan);
+            continue;
+        }
+        for_each_cell(qcx - r, qcy - r, qcx + r, qcy - r, scan);
+        for_each_cell(qcx - r, qcy + r, qcx + r, qcy + r, scan);
+        for_each_cell(qcx - r, qcy - r + 1, qcx - r, qcy + r - 1, scan);
+        for_each_cell(qcx + r, qcy - r + 1, qcx + r, qcy + r - 1, scan);
+    }
+    return found;
+}
+
+void query_closest(const SpatialHashGrid2D &grid,
+                   std::span<const Point_2> queries,
+                   std::size_t k,
+                   std::span<std::size_t> indices,
+                   std::span<double> sq_distances,
+                   parallel::ThreadPool &pool) {
+    assert(indices.size() >= queries.size() * k);
+    assert(sq_distances.size() >= queries.size() * k);
+    if (k == 0)
+        return;
+    pool.parallel_for(queries.size(), 256, [&](std::size_t begin, std::size_t end) {
+        for (auto q = begin; q < end; q++) {
+            auto row_indices = indices.subspan(q * k, k);
+            auto row_distances = sq_distances.subspan(q * k, k);
+            auto found = grid.query_closest(queries[q], row_indices, row_distances);
+            std::fill(row_indices.begin() + found, row_indices.end(), SpatialHashGrid2D::npos);
+            std::fill(row_distances.begin() + found, row_distances.end(), std::numeric_limits<double>::infinity());
+        }
+    });
+}
+
+} // namespace utils::math
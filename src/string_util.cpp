@@ -22,42 +22,116 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <random>
-#include <sstream>
+#include <algorithm>
+#include <cstring>
 #include <utils/string_util.h>
 
 
 namespace utils::string {
-std::random_device rd;
-std::mt19937 gen(rd());
-std::uniform_int_distribution<> dis(0, 15);
-std::uniform_int_distribution<> dis2(8, 11);
 
-// source: https://stackoverflow.com/a/60198074
-std::string uuid4() {
-    std::stringstream ss;
-    int i;
-    ss << std::hex;
-    for (i = 0; i < 8; i++) {
-        ss << dis(gen);
-    }
-    ss << "-";
-    for (i = 0; i < 4; i++) {
-        ss << dis(gen);
-    }
-    ss << "-4";
-    for (i = 0; i < 3; i++) {
-        ss << dis(gen);
+namespace {
+
+constexpr std::size_t uuid_chunk = 256;
+
+// offset in the text form of the two hex digits of each byte
+constexpr std::array<std::uint8_t, 16> digit_offsets{
+    0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34
+};
+
+constexpr std::array<std::size_t, 4> dash_offsets{8, 13, 18, 23};
+
+// two lowercase hex digits for every byte value
+constexpr auto hex_pairs = [] {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> pairs{};
+    for (int i = 0; i < 256; i++) {
+        pairs[2 * i] = digits[i >> 4];
+        pairs[2 * i + 1] = digits[i & 15];
     }
-    ss << "-";
-    ss << dis2(gen);
-    for (i = 0; i < 3; i++) {
-        ss << dis(gen);
+    return pairs;
+}();
+
+// value of every hex digit in either case, 0x10 marks a non digit
+constexpr auto hex_values = [] {
+    std::array<std::uint8_t, 256> values{};
+    values.fill(0x10);
+    for (int i = 0; i < 10; i++)
+        values['0' + i] = i;
+    for (int i = 0; i < 6; i++)
+        values['a' + i] = values['A' + i] = 10 + i;
+    return values;
+}();
+
+void set_uuid4(Uuid &uuid, std::uint64_t high, std::uint64_t low) {
+    std::memcpy(uuid.bytes.data(), &high, 8);
+    std::memcpy(uuid.bytes.data() + 8, &low, 8);
+    uuid.bytes[6] = (uuid.bytes[6] & 0x0f) | 0x40;
+    uuid.bytes[8] = (uuid.bytes[8] & 0x3f) | 0x80;
+}
+
+} // namespace
+
+void Uuid::to_chars(char *out) const {
+    for (auto offset: dash_offsets)
+        out[offset] = '-';
+    for (std::size_t i = 0; i < bytes.size(); i++)
+        std::memcpy(out + digit_offsets[i], hex_pairs.data() + 2 * bytes[i], 2);
+}
+
+std::string Uuid::to_string() const {
+    std::string text(string_size, '\0');
+    to_chars(text.data());
+    return text;
+}
+
+std::optional<Uuid> Uuid::parse(std::string_view text) {
+    if (text.size() != string_size)
+        return std::nullopt;
+    Uuid uuid;
+    // accumulate the bad digit flags and check once at the end instead of per character
+    std::uint8_t invalid = 0;
+    for (std::size_t i = 0; i < uuid.bytes.size(); i++) {
+        const auto high = hex_values[static_cast<unsigned char>(text[digit_offsets[i]])];
+        const auto low = hex_values[static_cast<unsigned char>(text[digit_offsets[i] + 1])];
+        invalid |= high | low;
+        uuid.bytes[i] = static_cast<std::uint8_t>(high << 4 | (low & 0x0f));
     }
-    ss << "-";
-    for (i = 0; i < 12; i++) {
-        ss << dis(gen);
+    for (auto offset: dash_offsets)
+        invalid |= text[offset] != '-' ? 0x10 : 0;
+    if (invalid & 0x10)
+        return std::nullopt;
+    return uuid;
+}
+
+void generate_uuid4(std::span<Uuid> out, random::Xoshiro256 &rng) {
+    std::uint64_t bits[2 * uuid_chunk];
+    for (std::size_t i = 0; i < out.size(); i += uuid_chunk) {
+        const auto count = std::min(uuid_chunk, out.size() - i);
+        random::fill_bits(std::span(bits, 2 * count), rng);
+        for (std::size_t j = 0; j < count; j++)
+            set_uuid4(out[i + j], bits[2 * j], bits[2 * j + 1]);
     }
-    return ss.str();
 }
-} // namespace utils::string
\ No newline at end of file
+
+Uuid generate_uuid4(random::Xoshiro256 &rng) {
+    Uuid uuid;
+    const auto high = rng();
+    set_uuid4(uuid, high, rng());
+    return uuid;
+}
+
+std::string uuid4() {
+    return generate_uuid4().to_string();
+}
+
+} // namespace utils::string
+
+std::size_t std::hash<utils::string::Uuid>::operator()(const utils::string::Uuid &uuid) const noexcept {
+    std::uint64_t high, low;
+    std::memcpy(&high, uuid.bytes.data(), 8);
+    std::memcpy(&low, uuid.bytes.data() + 8, 8);
+    // v4 ids are already random, but other versions share long runs of bits
+    std::uint64_t state = high;
+    state = utils::random::splitmix64(state) ^ low;
+    return utils::random::splitmix64(state);
+}
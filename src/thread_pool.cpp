@@ -0,0 +1,169 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utils/thread_pool.h>
+
+
+namespace utils::parallel {
+
+namespace {
+
+// the pool and deque of the worker running on this thread, if any
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    threads = std::max<std::size_t>(threads, 1);
+    queues_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++)
+        queues_.push_back(std::make_unique<Queue>());
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++)
+        workers_.emplace_back([this, i] { work(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+    for (auto &worker: workers_)
+        worker.join();
+}
+
+ThreadPool &ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    auto index = current_pool == this ? current_queue : next_queue_.fetch_add(1) % queues_.size();
+    {
+        std::lock_guard lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // under the sleep lock so a worker cannot miss it between its last look and waiting
+        std::lock_guard lock(mutex_);
+        pending_.fetch_add(1);
+    }
+    available_.notify_one();
+}
+
+bool ThreadPool::take(std::size_t index, std::function<void()> &task) {
+    {
+        auto &own = *queues_[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < queues_.size(); i++) {
+        auto &victim = *queues_[(index + i) % queues_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::work(std::size_t index) {
+    current_pool = this;
+    current_queue = index;
+    std::function<void()> task;
+    while (true) {
+        if (take(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock lock(mutex_);
+        available_.wait(lock, [this] { return stopping_ || pending_.load() > 0; });
+        if (stopping_ && pending_.load() <= 0)
+            return;
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t count, std::size_t grain,
+                              const std::function<void(std::size_t, std::size_t)> &op) {
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    if (chunks <= 1) {
+        if (count > 0)
+            op(0, count);
+        return;
+    }
+
+    // shared with helpers that may only get scheduled after the loop has finished
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::size_t completed{0};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<State>();
+    auto run = [state, chunks, count, grain, &op] {
+        std::size_t chunk;
+        while ((chunk = state->next.fetch_add(1)) < chunks) {
+            std::exception_ptr error;
+            try {
+                op(chunk * grain, std::min(count, (chunk + 1) * grain));
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard lock(state->mutex);
+            if (error && !state->error)
+                state->error = error;
+            if (++state->completed == chunks)
+                state->done.notify_all();
+        }
+    };
+
+    auto helpers = std::min(size(), chunks - 1);
+    for (std::size_t i = 0; i < helpers; i++)
+        submit(run);
+    run();
+
+    std::unique_lock lock(state->mutex);
+    state->done.wait(lock, [&] { return state->completed == chunks; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+} // namespace utils::parallel
@@ -0,0 +1,528 @@
+/* Created by Philip Smith on 10/17/26.
+MIT License
+
+Copyright (c) 2021 Philip Arturo Smith
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <utils/voronoi.h>
+
+
+namespace utils::math {
+
+namespace {
+
+constexpr int nil = 0;
+
+struct Arc {
+    int site{-1};
+    // red-black tree links
+    int parent{nil}, left{nil}, right{nil};
+    bool red{false};
+    // neighbours along the beachline
+    int prev{nil}, next{nil};
+    // half-edges traced by the left and right breakpoints
+    int left_edge{-1}, right_edge{-1};
+    int event{-1};
+};
+
+// Red-black tree of parabolic arcs ordered by x, threaded with a prev/next list.
+// Slot 0 is the black nil sentinel.
+class Beachline {
+public:
+    Beachline() : arcs_(1) {}
+
+    Arc &operator[](int i) {
+        return arcs_[i];
+    }
+
+    [[nodiscard]]
+    bool empty() const {
+        return root_ == nil;
+    }
+
+    [[nodiscard]]
+    int root() const {
+        return root_;
+    }
+
+    int create(int site) {
+        arcs_.emplace_back().site = site;
+        return static_cast<int>(arcs_.size() - 1);
+    }
+
+    void reserve(std::size_t n) {
+        arcs_.reserve(n + 1);
+    }
+
+    void set_root(int x) {
+        root_ = x;
+        arcs_[x].red = false;
+    }
+
+    [[nodiscard]]
+    int rightmost() const {
+        int x = root_;
+        while (arcs_[x].right != nil)
+            x = arcs_[x].right;
+        return x;
+    }
+
+    void insert_before(int x, int y) {
+        if (arcs_[x].left == nil) {
+            arcs_[x].left = y;
+            arcs_[y].parent = x;
+        } else {
+            int pred = arcs_[x].prev;
+            arcs_[pred].right = y;
+            arcs_[y].parent = pred;
+        }
+        arcs_[y].prev = arcs_[x].prev;
+        if (arcs_[y].prev != nil)
+            arcs_[arcs_[y].prev].next = y;
+        arcs_[y].next = x;
+        arcs_[x].prev = y;
+        insert_fixup(y);
+    }
+
+    void insert_after(int x, int y) {
+        if (arcs_[x].right == nil) {
+            arcs_[x].right = y;
+            arcs_[y].parent = x;
+        } else {
+            int succ = arcs_[x].next;
+            arcs_[succ].left = y;
+            arcs_[y].parent = succ;
+        }
+        arcs_[y].next = arcs_[x].next;
+        if (arcs_[y].next != nil)
+            arcs_[arcs_[y].next].prev = y;
+        arcs_[y].prev = x;
+        arcs_[x].next = y;
+        insert_fixup(y);
+    }
+
+    // put y in x's place, both in the tree and along the beachline
+    void replace(int x, int y) {
+        transplant(x, y);
+        Arc &a = arcs_[x], &b = arcs_[y];
+        b.left = a.left;
+        b.right = a.right;
+        b.red = a.red;
+        if (b.left != nil)
+            arcs_[b.left].parent = y;
+        if (b.right != nil)
+            arcs_[b.right].parent = y;
+        b.prev = a.prev;
+        b.next = a.next;
+        if (b.prev != nil)
+            arcs_[b.prev].next = y;
+        if (b.next != nil)
+            arcs_[b.next].prev = y;
+    }
+
+    void remove(int z) {
+        int y = z, x;
+        bool removed_red = arcs_[y].red;
+        if (arcs_[z].left == nil) {
+            x = arcs_[z].right;
+            transplant(z, x);
+        } else if (arcs_[z].right == nil) {
+            x = arcs_[z].left;
+            transplant(z, x);
+        } else {
+            y = arcs_[z].next;
+            removed_red = arcs_[y].red;
+            x = arcs_[y].right;
+            if (arcs_[y].parent == z) {
+                arcs_[x].parent = y;
+            } else {
+                transplant(y, x);
+                arcs_[y].right = arcs_[z].right;
+                arcs_[arcs_[y].right].parent = y;
+            }
+            transplant(z, y);
+            arcs_[y].left = arcs_[z].left;
+            arcs_[arcs_[y].left].parent = y;
+            arcs_[y].red = arcs_[z].red;
+        }
+        if (!removed_red)
+            remove_fixup(x);
+
+        if (arcs_[z].prev != nil)
+            arcs_[arcs_[z].prev].next = arcs_[z].next;
+        if (arcs_[z].next != nil)
+            arcs_[arcs_[z].next].prev = arcs_[z].prev;
+    }
+
+private:
+    void transplant(int u, int v) {
+        int p = arcs_[u].parent;
+        if (p == nil)
+            root_ = v;
+        else if (u == arcs_[p].left)
+            arcs_[p].left = v;
+        else
+            arcs_[p].right = v;
+        arcs_[v].parent = p;
+    }
+
+    void rotate_left(int x) {
+        int y = arcs_[x].right;
+        arcs_[x].right = arcs_[y].left;
+        if (arcs_[y].left != nil)
+            arcs_[arcs_[y].left].parent = x;
+        transplant(x, y);
+        arcs_[y].left = x;
+        arcs_[x].parent = y;
+    }
+
+    void rotate_right(int x) {
+        int y = arcs_[x].left;
+        arcs_[x].left = arcs_[y].right;
+        if (arcs_[y].right != nil)
+            arcs_[arcs_[y].right].parent = x;
+        transplant(x, y);
+        arcs_[y].right = x;
+        arcs_[x].parent = y;
+    }
+
+    void insert_fixup(int z) {
+        arcs_[z].left = arcs_[z].right = nil;
+        arcs_[z].red = true;
+        while (arcs_[arcs_[z].parent].red) {
+            int p = arcs_[z].parent, g = arcs_[p].parent;
+            if (p == arcs_[g].left) {
+                int u = arcs_[g].right;
+                if (arcs_[u].red) {
+                    arcs_[p].red = arcs_[u].red = false;
+                    arcs_[g].red = true;
+                    z = g;
+                } else {
+                    if (z == arcs_[p].right) {
+                        z = p;
+                        rotate_left(z);
+                        p = arcs_[z].parent;
+                    }
+                    arcs_[p].red = false;
+                    arcs_[g].red = true;
+                    rotate_right(g);
+                }
+            } else {
+                int u = arcs_[g].left;
+                if (arcs_[u].red) {
+                    arcs_[p].red = arcs_[u].red = false;
+                    arcs_[g].red = true;
+                    z = g;
+                } else {
+                    if (z == arcs_[p].left) {
+                        z = p;
+                        rotate_right(z);
+                        p = arcs_[z].parent;
+                    }
+                    arcs_[p].red = false;
+                    arcs_[g].red = true;
+                    rotate_left(g);
+                }
+            }
+        }
+        arcs_[root_].red = false;
+    }
+
+    void remove_fixup(int x) {
+        while (x != root_ && !arcs_[x].red) {
+            int p = arcs_[x].parent;
+            if (x == arcs_[p].left) {
+                int w = arcs_[p].right;
+                if (arcs_[w].red) {
+                    arcs_[w].red = false;
+                    arcs_[p].red = true;
+                    rotate_left(p);
+                    w = arcs_[p].right;
+                }
+                if (!arcs_[arcs_[w].left].red && !arcs_[arcs_[w].right].red) {
+                    arcs_[w].red = true;
+                    x = p;
+                } else {
+                    if (!arcs_[arcs_[w].right].red) {
+                        arcs_[arcs_[w].left].red = false;
+                        arcs_[w].red = true;
+                        rotate_right(w);
+                        w = arcs_[p].right;
+                    }
+                    arcs_[w].red = arcs_[p].red;
+                    arcs_[p].red = false;
+                    arcs_[arcs_[w].right].red = false;
+                    rotate_left(p);
+                    x = root_;
+                }
+            } else {
+                int w = arcs_[p].left;
+                if (arcs_[w].red) {
+                    arcs_[w].red = false;
+                    arcs_[p].red = true;
+                    rotate_right(p);
+                    w = arcs_[p].left;
+                }
+                if (!arcs_[arcs_[w].left].red && !arcs_[arcs_[w].right].red) {
+                    arcs_[w].red = true;
+                    x = p;
+                } else {
+                    if (!arcs_[arcs_[w].left].red) {
+                        arcs_[arcs_[w].right].red = false;
+                        arcs_[w].red = true;
+                        rotate_left(w);
+                        w = arcs_[p].left;
+                    }
+                    arcs_[w].red = arcs_[p].red;
+                    arcs_[p].red = false;
+                    arcs_[arcs_[w].left].red = false;
+                    rotate_right(p);
+                    x = root_;
+                }
+            }
+        }
+        arcs_[x].red = false;
+    }
+
+    std::vector<Arc> arcs_;
+    int root_{nil};
+};
+
+struct CircleEvent {
+    // sweep position at which the middle arc vanishes, the top of the circle
+    double y;
+    glm::dvec2 center;
+    int arc;
+    bool valid{true};
+};
+
+// min-heap order for circle events, lowest first
+struct Later {
+    const std::vector<CircleEvent> *circles;
+
+    bool operator()(int a, int b) const {
+        const auto &ea = (*circles)[a], &eb = (*circles)[b];
+        return ea.y > eb.y || (ea.y == eb.y && ea.center.x > eb.center.x);
+    }
+};
+
+class FortuneSweep {
+public:
+    FortuneSweep(std::vector<glm::dvec2> sites, std::vector<int> site_ids, VoronoiDiagram &diagram)
+            : sites_(std::move(sites)), site_ids_(std::move(site_ids)), diagram_(diagram),
+              events_(Later{&circles_}) {
+        beachline_.reserve(3 * sites_.size());
+        diagram_.vertices.reserve(2 * sites_.size());
+        diagram_.half_edges.reserve(6 * sites_.size());
+        diagram_.triangles.reserve(6 * sites_.size());
+    }
+
+    void run() {
+        std::size_t next_site = 0;
+        while (next_site < sites_.size() || !events_.empty()) {
+            if (!events_.empty() && !circles_[events_.top()].valid) {
+                events_.pop();
+                continue;
+            }
+            // circles closing at the same height as a site go first
+            if (next_site == sites_.size() || (!events_.empty() && circles_[events_.top()].y <= sites_[next_site].y)) {
+                int event = events_.top();
+                events_.pop();
+                handle_circle(event);
+            } else {
+                handle_site(static_cast<int>(next_site++));
+            }
+        }
+    }
+
+private:
+    double breakpoint(int left, int right, double directrix_y) {
+        return compute_parabolic_collision_x(sites_[beachline_[left].site], sites_[beachline_[right].site],
+                                             directrix_y);
+    }
+
+    int locate_arc_above(glm::dvec2 point) {
+        int x = beachline_.root();
+        while (true) {
+            const Arc &arc = beachline_[x];
+            if (arc.prev != nil && point.x < breakpoint(arc.prev, x, point.y))
+                x = arc.left;
+            else if (arc.next != nil && point.x > breakpoint(x, arc.next, point.y))
+                x = arc.right;
+            else
+                return x;
+        }
+    }
+
+    int add_half_edge(int site) {
+        auto &edge = diagram_.half_edges.emplace_back();
+        edge.site = site_ids_[site];
+        int id = static_cast<int>(diagram_.half_edges.size() - 1);
+        if (diagram_.cells[edge.site] == -1)
+            diagram_.cells[edge.site] = id;
+        return id;
+    }
+
+    // new edge traced by the breakpoint between two neighbouring arcs
+    void add_edge(int left, int right) {
+        int a = add_half_edge(beachline_[left].site);
+        int b = add_half_edge(beachline_[right].site);
+        diagram_.half_edges[a].twin = b;
+        diagram_.half_edges[b].twin = a;
+        beachline_[left].right_edge = a;
+        beachline_[right].left_edge = b;
+    }
+
+    void link(int prev, int next) {
+        diagram_.half_edges[prev].next = next;
+        diagram_.half_edges[next].prev = prev;
+    }
+
+    void invalidate(int arc) {
+        if (beachline_[arc].event != -1) {
+            circles_[beachline_[arc].event].valid = false;
+            beachline_[arc].event = -1;
+        }
+    }
+
+    void add_circle_event(int left, int middle, int right) {
+        auto a = sites_[beachline_[left].site], b = sites_[beachline_[middle].site], c = sites_[beachline_[right].site];
+        // the breakpoints around the middle arc only converge when the sites turn counterclockwise
+        if ((b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x) <= 0.0)
+            return;
+        auto center = compute_triangle_circumcenter(a, b, c);
+        double y = center.y + glm::length(b - center);
+        circles_.push_back({y, center, middle});
+        beachline_[middle].event = static_cast<int>(circles_.size() - 1);
+        events_.push(beachline_[middle].event);
+    }
+
+    void handle_site(int site) {
+        if (beachline_.empty()) {
+            beachline_.set_root(beachline_.create(site));
+            return;
+        }
+        // sites sharing the first row have no arc above them yet, they line up left to right
+        if (sites_[site].y == sites_[0].y) {
+            int last = beachline_.rightmost();
+            int arc = beachline_.create(site);
+            beachline_.insert_after(last, arc);
+            add_edge(last, arc);
+            return;
+        }
+
+        int above = locate_arc_above(sites_[site]);
+        invalidate(above);
+
+        // split the arc above into left | middle | right
+        int middle = beachline_.create(site);
+        int left = beachline_.create(beachline_[above].site);
+        int right = beachline_.create(beachline_[above].site);
+        beachline_[left].left_edge = beachline_[above].left_edge;
+        beachline_[right].right_edge = beachline_[above].right_edge;
+        beachline_.replace(above, middle);
+        beachline_.insert_before(middle, left);
+        beachline_.insert_after(middle, right);
+
+        add_edge(left, middle);
+        beachline_[middle].right_edge = beachline_[middle].left_edge;
+        beachline_[right].left_edge = beachline_[left].right_edge;
+
+        if (beachline_[left].prev != nil)
+            add_circle_event(beachline_[left].prev, left, middle);
+        if (beachline_[right].next != nil)
+            add_circle_event(middle, right, beachline_[right].next);
+    }
+
+    void handle_circle(int event) {
+        diagram_.vertices.push_back(circles_[event].center);
+        int vertex = static_cast<int>(diagram_.vertices.size() - 1);
+
+        int arc = circles_[event].arc;
+        int prev = beachline_[arc].prev, next = beachline_[arc].next;
+        beachline_[arc].event = -1;
+        invalidate(prev);
+        invalidate(next);
+        diagram_.triangles.insert(diagram_.triangles.end(), {site_ids_[beachline_[prev].site],
+                                                             site_ids_[beachline_[arc].site],
+                                                             site_ids_[beachline_[next].site]});
+
+        // close the two edges meeting at the vertex
+        auto &half_edges = diagram_.half_edges;
+        half_edges[beachline_[prev].right_edge].origin = vertex;
+        half_edges[beachline_[arc].left_edge].destination = vertex;
+        half_edges[beachline_[arc].right_edge].origin = vertex;
+        half_edges[beachline_[next].left_edge].destination = vertex;
+        link(beachline_[arc].left_edge, beachline_[arc].right_edge);
+        beachline_.remove(arc);
+
+        // and start the one between the arcs that are now neighbours
+        int prev_edge = beachline_[prev].right_edge;
+        int next_edge = beachline_[next].left_edge;
+        add_edge(prev, next);
+        half_edges[beachline_[prev].right_edge].destination = vertex;
+        half_edges[beachline_[next].left_edge].origin = vertex;
+        link(beachline_[prev].right_edge, prev_edge);
+        link(next_edge, beachline_[next].left_edge);
+
+        if (beachline_[prev].prev != nil)
+            add_circle_event(beachline_[prev].prev, prev, next);
+        if (beachline_[next].next != nil)
+            add_circle_event(prev, next, beachline_[next].next);
+    }
+
+    std::vector<glm::dvec2> sites_;
+    std::vector<int> site_ids_;
+    VoronoiDiagram &diagram_;
+    Beachline beachline_;
+    std::vector<CircleEvent> circles_;
+    std::priority_queue<int, std::vector<int>, Later> events_;
+};
+
+} // namespace
+
+VoronoiDiagram compute_voronoi(const std::vector<Point_2> &points) {
+    VoronoiDiagram diagram;
+    diagram.cells.assign(points.size(), -1);
+
+    // sweep order, dropping duplicate sites
+    std::vector<int> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return points[a].y() < points[b].y() || (points[a].y() == points[b].y() && points[a].x() < points[b].x());
+    });
+    order.erase(std::unique(order.begin(), order.end(), [&](int a, int b) {
+        return points[a] == points[b];
+    }), order.end());
+
+    std::vector<glm::dvec2> sites;
+    sites.reserve(order.size());
+    for (auto i: order)
+        sites.emplace_back(points[i].x(), points[i].y());
+
+    FortuneSweep(std::move(sites), std::move(order), diagram).run();
+    return diagram;
+}
+
+} // namespace utils::math